@@ -1,19 +1,23 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <termios.h>
+#include <time.h>
 #include <unistd.h>
-#include <fcntl.h>
-#include <sys/time.h>
+#include <sys/select.h>
 #include <sys/types.h>
 
 #define MAX_X 80
 #define MAX_Y 25
-#define BALL_SPEED 5  // Количество кадров между движениями мяча
+#define SCREEN_ROWS (MAX_Y + 1)  // Поле + строка со счетом
+#define TICK_US 50000            // Шаг симуляции мяча: 50 мс, не зависит от частоты отрисовки
+#define MAX_TICKS_PER_FRAME 5    // Не догоняем больше 5 шагов после долгой паузы
+#define WIN_SCORE 20
+#define OUT_BUF_SIZE 32768
 
 typedef struct {
     int x, y;
     int speed_x, speed_y;
-    int move_counter;
 } Ball;
 
 typedef struct {
@@ -27,12 +31,20 @@ typedef struct {
     int left_score, right_score;
 } GameState;
 
+// Два кадра: что сейчас на терминале и что должно быть. Отправляем только разницу.
+typedef struct {
+    char shown[SCREEN_ROWS][MAX_X];
+    char next[SCREEN_ROWS][MAX_X];
+    int has_shown;
+    char out[OUT_BUF_SIZE];
+    size_t out_len;
+} Renderer;
+
 void init_game(GameState *game) {
     game->ball.x = MAX_X / 2;
     game->ball.y = MAX_Y / 2;
     game->ball.speed_x = 1;
     game->ball.speed_y = 1;
-    game->ball.move_counter = 0;
 
     game->left_racket.start = 10;
     game->left_racket.end = 14;
@@ -45,76 +57,44 @@ void init_game(GameState *game) {
     game->left_score = game->right_score = 0;
 }
 
-void draw_vertical_line(int x, int start, int end) {
-    for (int y = start; y <= end; y++) {
-        printf("\033[%d;%dH|", y, x);
-    }
+long long now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
 }
 
-void draw_game(GameState *game) {
-    printf("\033[2J"); // Clear screen
-    printf("\033[H");  // Move cursor to home position
+// Один шаг физики мяча. Вызывается строго раз в TICK_US.
+void step_ball(GameState *game) {
+    game->ball.x += game->ball.speed_x;
+    game->ball.y += game->ball.speed_y;
 
-    // Draw borders
-    for (int i = 0; i < MAX_X; i++) {
-        printf("\033[1;%dH-", i + 1);
-        printf("\033[%d;%dH-", MAX_Y, i + 1);
-    }
-    for (int i = 0; i < MAX_Y; i++) {
-        printf("\033[%d;1H|", i + 1);
-        printf("\033[%d;%dH|", i + 1, MAX_X);
+    // Ball collision with top and bottom
+    if (game->ball.y <= 1 || game->ball.y >= MAX_Y - 1) {
+        game->ball.speed_y = -game->ball.speed_y;
     }
 
-    // Draw rackets
-    draw_vertical_line(game->left_racket.x, game->left_racket.start, game->left_racket.end);
-    draw_vertical_line(game->right_racket.x, game->right_racket.start, game->right_racket.end);
-
-    // Draw ball
-    printf("\033[%d;%dH*", game->ball.y, game->ball.x);
-
-    // Draw scores
-    printf("\033[%d;%dHLeft: %d  Right: %d", MAX_Y + 1, 1, game->left_score, game->right_score);
-    
-    fflush(stdout);  // Ensure output is displayed immediately
-}
-
-void update_game(GameState *game, char input) {
-    // Update ball position
-    game->ball.move_counter++;
-    if (game->ball.move_counter >= BALL_SPEED) {
-        game->ball.x += game->ball.speed_x;
-        game->ball.y += game->ball.speed_y;
-        game->ball.move_counter = 0;
-
-        // Ball collision with top and bottom
-        if (game->ball.y <= 1 || game->ball.y >= MAX_Y - 1) {
-            game->ball.speed_y = -game->ball.speed_y;
-        }
-
-        // Ball collision with rackets
-        if ((game->ball.x == game->left_racket.x + 1 && 
-             game->ball.y >= game->left_racket.start && 
-             game->ball.y <= game->left_racket.end) ||
-            (game->ball.x == game->right_racket.x - 1 && 
-             game->ball.y >= game->right_racket.start && 
-             game->ball.y <= game->right_racket.end)) {
-            game->ball.speed_x = -game->ball.speed_x;
-        }
+    // Ball collision with rackets
+    if ((game->ball.x == game->left_racket.x + 1 && game->ball.y >= game->left_racket.start &&
+         game->ball.y <= game->left_racket.end) ||
+        (game->ball.x == game->right_racket.x - 1 && game->ball.y >= game->right_racket.start &&
+         game->ball.y <= game->right_racket.end)) {
+        game->ball.speed_x = -game->ball.speed_x;
+    }
 
-        // Scoring
-        if (game->ball.x <= 1) {
-            game->right_score++;
-            game->ball.x = MAX_X / 2;
-            game->ball.y = MAX_Y / 2;
-        } else if (game->ball.x >= MAX_X - 1) {
-            game->left_score++;
-            game->ball.x = MAX_X / 2;
-            game->ball.y = MAX_Y / 2;
-        }
+    // Scoring
+    if (game->ball.x <= 1) {
+        game->right_score++;
+        game->ball.x = MAX_X / 2;
+        game->ball.y = MAX_Y / 2;
+    } else if (game->ball.x >= MAX_X - 1) {
+        game->left_score++;
+        game->ball.x = MAX_X / 2;
+        game->ball.y = MAX_Y / 2;
     }
+}
 
-    // Racket movement
-    switch(input) {
+void move_rackets(GameState *game, char input) {
+    switch (input) {
         case 'a':
             if (game->left_racket.start > 1) {
                 game->left_racket.start--;
@@ -142,15 +122,109 @@ void update_game(GameState *game, char input) {
     }
 }
 
-int kbhit(void) {
-    struct timeval tv = { 0L, 0L };
+int is_game_over(const GameState *game) {
+    return game->left_score >= WIN_SCORE || game->right_score >= WIN_SCORE;
+}
+
+void out_flush(Renderer *r) {
+    size_t done = 0;
+    while (done < r->out_len) {
+        ssize_t n = write(STDOUT_FILENO, r->out + done, r->out_len - done);
+        if (n <= 0) break;
+        done += (size_t)n;
+    }
+    r->out_len = 0;
+}
+
+// Переполненный буфер сбрасывается в терминал: кадр уйдет несколькими write(), но целиком
+void out_append(Renderer *r, const char *s, size_t len) {
+    if (r->out_len + len > OUT_BUF_SIZE) out_flush(r);
+    memcpy(r->out + r->out_len, s, len);
+    r->out_len += len;
+}
+
+void put_cell(Renderer *r, int row, int col, char c) {
+    if (row >= 1 && row <= SCREEN_ROWS && col >= 1 && col <= MAX_X) {
+        r->next[row - 1][col - 1] = c;
+    }
+}
+
+// Собираем кадр в памяти: координаты 1-based, как в ANSI escape-последовательностях
+void compose_frame(Renderer *r, const GameState *game) {
+    memset(r->next, ' ', sizeof(r->next));
+
+    // Borders
+    for (int i = 1; i <= MAX_X; i++) {
+        put_cell(r, 1, i, '-');
+        put_cell(r, MAX_Y, i, '-');
+    }
+    for (int i = 1; i <= MAX_Y; i++) {
+        put_cell(r, i, 1, '|');
+        put_cell(r, i, MAX_X, '|');
+    }
+
+    // Rackets
+    for (int y = game->left_racket.start; y <= game->left_racket.end; y++) {
+        put_cell(r, y, game->left_racket.x, '|');
+    }
+    for (int y = game->right_racket.start; y <= game->right_racket.end; y++) {
+        put_cell(r, y, game->right_racket.x, '|');
+    }
+
+    // Ball
+    put_cell(r, game->ball.y, game->ball.x, '*');
+
+    // Scores
+    char score[MAX_X + 1];
+    int len = snprintf(score, sizeof(score), "Left: %d  Right: %d", game->left_score, game->right_score);
+    for (int i = 0; i < len && i < MAX_X; i++) {
+        put_cell(r, SCREEN_ROWS, i + 1, score[i]);
+    }
+}
+
+// Отправляем в терминал только изменившиеся клетки, обычно одним write()
+void render_diff(Renderer *r) {
+    char seq[32];
+    int cursor_row = -1, cursor_col = -1;
+
+    if (!r->has_shown) {
+        out_append(r, "\033[2J", 4);
+        memset(r->shown, ' ', sizeof(r->shown));
+        r->has_shown = 1;
+    }
+
+    for (int row = 0; row < SCREEN_ROWS; row++) {
+        for (int col = 0; col < MAX_X; col++) {
+            char c = r->next[row][col];
+            if (c == r->shown[row][col]) continue;
+
+            // Соседние клетки в строке пишем подряд, без повторного позиционирования
+            if (row != cursor_row || col != cursor_col) {
+                int len = snprintf(seq, sizeof(seq), "\033[%d;%dH", row + 1, col + 1);
+                out_append(r, seq, (size_t)len);
+            }
+            out_append(r, &c, 1);
+            r->shown[row][col] = c;
+            cursor_row = row;
+            cursor_col = col + 1;
+        }
+    }
+
+    out_flush(r);
+}
+
+// Ждем ввода не дольше timeout_us: процесс спит, а не крутит цикл
+int wait_input(long long timeout_us) {
+    if (timeout_us < 0) timeout_us = 0;
+    struct timeval tv = {(time_t)(timeout_us / 1000000), (suseconds_t)(timeout_us % 1000000)};
     fd_set fds;
     FD_ZERO(&fds);
-    FD_SET(0, &fds);
-    return select(1, &fds, NULL, NULL, &tv) > 0;
+    FD_SET(STDIN_FILENO, &fds);
+    return select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) > 0;
 }
 
 int main(void) {
+    static Renderer renderer;
     GameState game;
     init_game(&game);
 
@@ -160,26 +234,52 @@ int main(void) {
     newt.c_lflag &= ~(ICANON | ECHO);
     tcsetattr(STDIN_FILENO, TCSANOW, &newt);
 
-    while (1) {
-        draw_game(&game);
+    int running = 1;
+    int dirty = 1;
+    long long next_tick = now_us() + TICK_US;
 
-        char input = 0;
-        if (kbhit()) {
-            input = getchar();
-            if (input == 'q') break;
+    while (running && !is_game_over(&game)) {
+        // Фиксированный шаг: сколько тиков прошло, столько шагов и делаем
+        long long now = now_us();
+        int ticks = 0;
+        while (now >= next_tick && ticks < MAX_TICKS_PER_FRAME && !is_game_over(&game)) {
+            step_ball(&game);
+            next_tick += TICK_US;
+            ticks++;
+            dirty = 1;
+        }
+        if (now >= next_tick) {
+            next_tick = now + TICK_US;
         }
 
-        update_game(&game, input);
-
-        usleep(10000);  // Уменьшенная задержка для более плавного управления
+        if (dirty) {
+            compose_frame(&renderer, &game);
+            render_diff(&renderer);
+            dirty = 0;
+        }
+        if (is_game_over(&game)) break;
 
-        if (game.left_score >= 20 || game.right_score >= 20) {
-            printf("\033[%d;%dHGame Over! %s wins!", MAX_Y + 2, 1, 
-                   game.left_score >= 20 ? "Left player" : "Right player");
-            break;
+        if (wait_input(next_tick - now_us())) {
+            char input[64];
+            ssize_t n = read(STDIN_FILENO, input, sizeof(input));
+            if (n <= 0) break;
+            for (ssize_t i = 0; i < n && running; i++) {
+                if (input[i] == 'q') {
+                    running = 0;
+                } else {
+                    move_rackets(&game, input[i]);
+                    dirty = 1;
+                }
+            }
         }
     }
 
+    if (is_game_over(&game)) {
+        printf("\033[%d;%dHGame Over! %s wins!", MAX_Y + 2, 1,
+               game.left_score >= WIN_SCORE ? "Left player" : "Right player");
+        fflush(stdout);
+    }
+
     tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
     return 0;
-}
\ No newline at end of file
+}
@@ -1,29 +1,89 @@
+#include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+    Операторы % и / по условию задания запрещены. Вместо них:
+    - divmod_shift() - двоичное деление "в столбик" сдвигами, O(log n);
+    - проверка делимости на простое p умножением на обратный элемент p^-1 mod 2^64
+      (n делится на p <=> n * p^-1 <= ULONG_MAX / p, и тогда n * p^-1 - это частное);
+    - арифметика Монтгомери для Миллера-Рабина и Полларда, где остаток заменяется сдвигом.
+*/
+
+#define SIEVE_LIMIT 65536  // Простые до 2^16 закрывают пробное деление для чисел до 2^32
+#define MAX_SMALL_PRIMES 6542
+#define READ_BUF_SIZE 65536
+#define WRITE_BUF_SIZE 65536
+
+typedef unsigned long u64;
+typedef unsigned __int128 u128;
+
+typedef struct {
+    u64 p;
+    u64 inv;  // p^-1 mod 2^64
+    u64 lim;  // ULONG_MAX / p
+} SmallPrime;
+
+typedef struct {
+    u64 n;
+    u64 inv;  // n^-1 mod 2^64
+    u64 one;  // R mod n, R = 2^64
+    u64 r2;   // R^2 mod n
+} Montgomery;
+
+static SmallPrime small_primes[MAX_SMALL_PRIMES];
+static int small_primes_count = 0;
 
 int scan_int_and_check(int qnt);
-int largest_prime_divisor(long num);
-int process(long num);
+int process(u64 abs_num);
+int process_batch(void);
+u64 largest_prime_divisor(u64 num);
 
-int is_even(long n);
-long divide_with_subtract(long a, long b);
-long modulo_with_subtract(long a, long b);
-long is_prime(long n);
+int is_even(u64 n);
+u64 divmod_shift(u64 a, u64 b, u64 *rem);
+u64 inverse_2_64(u64 a);
+void build_sieve(void);
+u64 trial_divide(u64 *num);
+int is_prime(u64 n);
+u64 pollard_rho(u64 n);
+u64 largest_factor_rho(u64 n);
 
-int main() { return scan_int_and_check(1); }
+int main(int argc, char *argv[]) {
+    build_sieve();
+    if (argc == 2 && strcmp(argv[1], "--batch") == 0) {
+        return process_batch();
+    }
+    return scan_int_and_check(1);
+}
 
+/*
+    Число читается строкой и разбирается strtoull, чтобы принять весь диапазон u64
+    по модулю: "%ld" останавливался на 2^63 - 1. Знак снимается заранее, потому что
+    strtoull молча переворачивает отрицательные числа.
+*/
 int scan_int_and_check(int req_qnt) {
     int qnt;
-    long res;
+    char token[32];
     char after;
 
     if (req_qnt == 1) {
-        qnt = scanf("%ld%c", &res, &after);
+        qnt = scanf("%31s%c", token, &after);
     } else {
         printf("Not implemented");
         return 1;
     }
 
-    if (qnt != req_qnt + 1 || after != '\n') {
+    const char *digits = token[0] == '-' ? token + 1 : token;
+    char *end = NULL;
+    u64 res = 0;
+    if (qnt == req_qnt + 1 && after == '\n' && *digits >= '0' && *digits <= '9') {
+        errno = 0;
+        res = strtoull(digits, &end, 10);
+    }
+
+    if (end == NULL || *end != '\0' || errno == ERANGE) {
         printf("n/a");
         return 1;
     }
@@ -31,92 +91,311 @@ int scan_int_and_check(int req_qnt) {
     return process(res);
 }
 
-int process(long num) {
-    if (num < 0) {
-        num = -num;
-    }
-    int res = largest_prime_divisor(num);
-    if (num == -1) {
-        printf("n/a");
-        return 1;
+int process(u64 abs_num) {
+    u64 res = largest_prime_divisor(abs_num);
+    if (res == 0) {
+        printf("-1");
     } else {
-        printf("%d", res);
+        printf("%lu", res);
     }
     return 0;
 }
 
-int is_even(long num) {
-    while (num > 1) {
-        num -= 2;
+/*
+    Пакетный режим: числа из stdin через пробельные символы, по ответу на строку.
+    Решето строится один раз на весь поток, ввод и вывод идут блоками через read()/write().
+*/
+static char out_buf[WRITE_BUF_SIZE];
+static size_t out_len = 0;
+
+static void out_flush(void) {
+    size_t done = 0;
+    while (done < out_len) {
+        ssize_t n = write(STDOUT_FILENO, out_buf + done, out_len - done);
+        if (n <= 0) break;
+        done += (size_t)n;
     }
-    return num == 0;
+    out_len = 0;
 }
 
-long divide_with_subtract(long a, long b) {
-    int quotient = 0;
-    while (a >= b) {
-        a -= b;
-        quotient++;
+static void out_str(const char *s, size_t len) {
+    if (out_len + len > WRITE_BUF_SIZE) out_flush();
+    memcpy(out_buf + out_len, s, len);
+    out_len += len;
+}
+
+static void out_result(int valid, u64 num) {
+    char digits[24];
+    int pos = 24;
+    u64 res = valid ? largest_prime_divisor(num) : 0;
+
+    if (!valid) {
+        out_str("n/a\n", 4);
+    } else if (res == 0) {
+        out_str("-1\n", 3);
+    } else {
+        digits[--pos] = '\n';
+        while (res) {
+            u64 digit;
+            res = divmod_shift(res, 10, &digit);
+            digits[--pos] = (char)('0' + digit);
+        }
+        out_str(digits + pos, (size_t)(24 - pos));
     }
-    return quotient;
 }
 
-long modulo_with_subtract(long a, long b) {
-    while (a >= b) {
-        a -= b;
+/*
+    value * 10 + d > ULONG_MAX <=> value > (ULONG_MAX - d) / 10. Деление запрещено, поэтому
+    граница записана константой: ULONG_MAX = 1844674407370955161 * 10 + 5.
+*/
+static int digit_overflows(u64 value, u64 d) {
+    return value > 1844674407370955161UL || (value == 1844674407370955161UL && d > 5);
+}
+
+int process_batch(void) {
+    static char in_buf[READ_BUF_SIZE];
+    ssize_t len;
+    int in_token = 0, valid = 1, negative = 0, digits = 0;
+    u64 value = 0;
+
+    while ((len = read(STDIN_FILENO, in_buf, sizeof(in_buf))) > 0) {
+        for (ssize_t i = 0; i < len; i++) {
+            char c = in_buf[i];
+            if (c == ' ' || c == '\n' || c == '\t' || c == '\r') {
+                if (in_token) out_result(valid && digits > 0, value);
+                in_token = 0;
+            } else {
+                if (!in_token) {
+                    in_token = 1;
+                    valid = 1;
+                    negative = 0;
+                    digits = 0;
+                    value = 0;
+                }
+                if (c == '-' && !digits && !negative) {
+                    negative = 1;
+                } else if (c >= '0' && c <= '9' && !digit_overflows(value, (u64)(c - '0'))) {
+                    value = (value << 3) + (value << 1) + (u64)(c - '0');
+                    digits++;
+                } else {
+                    valid = 0;
+                }
+            }
+        }
     }
-    return a;
+    if (in_token) out_result(valid && digits > 0, value);
+    out_flush();
+    return 0;
 }
 
-long is_prime(long num) {
-    if (num <= 1) return 0;
-    if (num == 2) return 1;
-    if (is_even(num)) return 0;
+int is_even(u64 num) { return (num & 1) == 0; }
+
+/*
+    Деление в столбик: по одному биту делимого, от старшего к младшему.
+    carry хранит бит, вытолкнутый сдвигом, если остаток был >= 2^63.
+*/
+u64 divmod_shift(u64 a, u64 b, u64 *rem) {
+    u64 quotient = 0, r = 0;
+    int bit = a ? 63 - __builtin_clzl(a) : -1;
 
-    for (int i = 3; i * i <= num; i += 2) {
-        if (modulo_with_subtract(num, i) == 0) {
-            return 0;
+    for (; bit >= 0; bit--) {
+        u64 carry = r >> 63;
+        r = (r << 1) | ((a >> bit) & 1);
+        if (carry || r >= b) {
+            r -= b;
+            quotient |= 1UL << bit;
         }
     }
-    return 1;
+    if (rem) *rem = r;
+    return quotient;
 }
 
-int largest_prime_divisor(long num) {
-    if (num <= 1) {
-        return -1;
+// Обратный элемент по модулю 2^64 для нечетного a (итерации Ньютона, точность удваивается)
+u64 inverse_2_64(u64 a) {
+    u64 inv = a;
+    for (int i = 0; i < 5; i++) {
+        inv *= 2 - a * inv;
     }
+    return inv;
+}
 
-    int largest = 1;
-    for (int i = 2; i <= num; i++) {
-        if (is_prime(i) && modulo_with_subtract(num, i) == 0 && i > largest) {
-            largest = i;
+void build_sieve(void) {
+    static char composite[SIEVE_LIMIT];
+
+    if (small_primes_count) return;
+    for (u64 i = 2; i < SIEVE_LIMIT; i++) {
+        if (composite[i]) continue;
+        for (u64 j = i * i; j < SIEVE_LIMIT; j += i) {
+            composite[j] = 1;
         }
+        SmallPrime *sp = &small_primes[small_primes_count++];
+        sp->p = i;
+        sp->inv = i == 2 ? 0 : inverse_2_64(i);
+        sp->lim = divmod_shift(~0UL, i, NULL);
     }
-    return largest;
 }
 
 /*
-    OLD STUFF
+    Пробное деление до sqrt(num) по простым из решета. Найденный множитель сразу
+    делится нацело, и граница sqrt(num) сжимается вместе с num.
+    Возвращает наибольший найденный простой делитель, в *num остается неразложенная часть.
+*/
+u64 trial_divide(u64 *num) {
+    u64 n = *num, largest = 0;
+
+    if (is_even(n)) {
+        largest = 2;
+        n >>= __builtin_ctzl(n);
+    }
+    for (int i = 1; i < small_primes_count && small_primes[i].p * small_primes[i].p <= n; i++) {
+        const SmallPrime *sp = &small_primes[i];
+        u64 q = n * sp->inv;
+        while (q <= sp->lim) {
+            largest = sp->p;
+            n = q;
+            q = n * sp->inv;
+        }
+    }
+    if (n > 1 && n < (u64)SIEVE_LIMIT * SIEVE_LIMIT) {
+        // Делителей до sqrt(n) нет - остаток простой
+        if (n > largest) largest = n;
+        n = 1;
+    }
+    *num = n;
+    return largest;
+}
 
-int scan_2float();
-int check_2float(int qnt, double num1, double num2, char ch);
+static u64 mont_reduce(const Montgomery *m, u128 t) {
+    u64 hi = (u64)(t >> 64);
+    u64 q = (u64)t * m->inv;
+    u64 sub = (u64)(((u128)q * m->n) >> 64);
+    return hi >= sub ? hi - sub : hi - sub + m->n;
+}
 
-int scan_2float() {
-    double num1, num2;
-    int qnt;
-    char ch;
+static u64 mont_mul(const Montgomery *m, u64 a, u64 b) { return mont_reduce(m, (u128)a * b); }
 
-    qnt = scanf("%lf %lf%c", &num1, &num2, &ch);
+static u64 mod_add(u64 a, u64 b, u64 n) { return a >= n - b ? a - (n - b) : a + b; }
 
-    return check_float(qnt, num1, num2, ch);
+static void mont_init(Montgomery *m, u64 n) {
+    m->n = n;
+    m->inv = inverse_2_64(n);
+    divmod_shift(0UL - n, n, &m->one);  // 2^64 mod n = (2^64 - n) mod n
+    m->r2 = m->one;
+    for (int i = 0; i < 64; i++) {
+        m->r2 = mod_add(m->r2, m->r2, n);
+    }
 }
 
-int check_float(int qnt, double num1, double num2, char ch) {
-    if (qnt == 3 && ch == '\n') {
-        gotcha(num1, num2);
-    } else {
-        printf("n/a");
-        return 1;
+static u64 mont_from(const Montgomery *m, u64 a) { return mont_mul(m, a, m->r2); }
+
+static u64 mont_pow(const Montgomery *m, u64 base, u64 exp) {
+    u64 res = m->one;
+    while (exp) {
+        if (exp & 1) res = mont_mul(m, res, base);
+        base = mont_mul(m, base, base);
+        exp >>= 1;
+    }
+    return res;
+}
+
+// Детерминированный Миллер-Рабин для 64-битных n (первые 12 простых в качестве оснований)
+int is_prime(u64 n) {
+    static const u64 bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    Montgomery m;
+
+    if (n < 2) return 0;
+    for (int i = 0; i < 12; i++) {
+        if (n == bases[i]) return 1;
+    }
+    if (is_even(n)) return 0;
+
+    mont_init(&m, n);
+    u64 minus_one = n - m.one;
+    int s = __builtin_ctzl(n - 1);
+    u64 d = (n - 1) >> s;
+
+    for (int i = 0; i < 12; i++) {
+        u64 x = mont_pow(&m, mont_from(&m, bases[i]), d);
+        if (x == m.one || x == minus_one) continue;
+        int witness = 1;
+        for (int r = 1; r < s && witness; r++) {
+            x = mont_mul(&m, x, x);
+            if (x == minus_one) witness = 0;
+        }
+        if (witness) return 0;
+    }
+    return 1;
+}
+
+static u64 gcd_binary(u64 a, u64 b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int shift = __builtin_ctzl(a | b);
+    a >>= __builtin_ctzl(a);
+    while (b) {
+        b >>= __builtin_ctzl(b);
+        if (a > b) {
+            u64 t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+/*
+    Ро-метод Полларда в варианте Брента: разности |x - y| накапливаются произведением
+    и gcd считается раз в 128 шагов. n - нечетное составное.
+*/
+u64 pollard_rho(u64 n) {
+    Montgomery m;
+    mont_init(&m, n);
+
+    for (u64 c = 1;; c++) {
+        u64 y = mont_from(&m, 2), cm = mont_from(&m, c), x = y, ys = y, q = m.one, g = 1;
+        for (u64 r = 1; g == 1; r <<= 1) {
+            x = y;
+            for (u64 i = 0; i < r; i++) y = mod_add(mont_mul(&m, y, y), cm, n);
+            for (u64 k = 0; k < r && g == 1; k += 128) {
+                ys = y;
+                for (u64 i = 0; i < 128 && i < r - k; i++) {
+                    y = mod_add(mont_mul(&m, y, y), cm, n);
+                    q = mont_mul(&m, q, x > y ? x - y : y - x);
+                }
+                g = gcd_binary(q, n);
+            }
+        }
+        if (g == n) {
+            // Произведение обнулилось - повторяем последний блок по одному шагу
+            do {
+                ys = mod_add(mont_mul(&m, ys, ys), cm, n);
+                g = gcd_binary(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n) return g;
+    }
+}
+
+u64 largest_factor_rho(u64 n) {
+    if (n == 1) return 0;
+    if (is_prime(n)) return n;
+    u64 d = pollard_rho(n);
+    u64 a = largest_factor_rho(d);
+    u64 b = largest_factor_rho(divmod_shift(n, d, NULL));
+    return a > b ? a : b;
+}
+
+// 0 - у числа нет простых делителей (0 и 1)
+u64 largest_prime_divisor(u64 num) {
+    if (num <= 1) {
+        return 0;
     }
+
+    u64 largest = trial_divide(&num);
+    if (num > 1) {
+        u64 big = largest_factor_rho(num);
+        if (big > largest) largest = big;
+    }
+    return largest;
 }
-*/
\ No newline at end of file
@@ -1,8 +1,30 @@
 #include <stdio.h>
+#include <unistd.h>
 
-void encode(char c);
-void decode(char high, char low);
-int char_to_int(char c);
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*
+    Потоковый кодек: stdin читается блоками через read(), ответ копится в буфере
+    и уходит одним write() на блок. Символы переводятся по таблицам на 256 элементов.
+    Токен может разрезаться границей блока - недочитанный хвост переносится в начало буфера.
+*/
+
+#define READ_BUF_SIZE 65536
+#define OUT_BUF_SIZE (2 * READ_BUF_SIZE + 16)
+#define INVALID_HEX 0xFF
+
+static unsigned char hex_value[256];  // '0'-'9', 'A'-'F' -> 0..15, остальное INVALID_HEX
+static char hex_pair[256][2];         // байт -> две заглавные hex-цифры
+
+static unsigned char in_buf[READ_BUF_SIZE + 4];
+static char out_buf[OUT_BUF_SIZE];
+static size_t out_len = 0;
+
+void init_tables(void);
+int encode_stream(void);
+int decode_stream(void);
 
 int main(int argc, char *argv[]) {
     if (argc != 2) {
@@ -10,108 +32,210 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    init_tables();
     // читаем буквы
     if (*argv[1] == '0') {
-        char c1, c2;
-        int result;
-        int first = 1;
+        return encode_stream();
+        // читаем HEX
+    } else if (*argv[1] == '1') {
+        return decode_stream();
+    } else {
+        printf("n/a");
+        return 1;
+    }
+}
 
-        while (1) {
-            result = scanf("%c%c", &c1, &c2);
+void init_tables(void) {
+    const char *digits = "0123456789ABCDEF";
+    for (int i = 0; i < 256; i++) {
+        hex_value[i] = INVALID_HEX;
+        hex_pair[i][0] = digits[i >> 4];
+        hex_pair[i][1] = digits[i & 0xF];
+    }
+    for (int i = 0; i < 16; i++) {
+        hex_value[(unsigned char)digits[i]] = (unsigned char)i;
+    }
+}
 
-            if (c1 == '\n') {
-                break;
-            }
+void flush_out(void) {
+    size_t done = 0;
+    while (done < out_len) {
+        ssize_t n = write(STDOUT_FILENO, out_buf + done, out_len - done);
+        if (n <= 0) break;
+        done += (size_t)n;
+    }
+    out_len = 0;
+}
 
-            // Если только один символ был прочитан, это должен быть последний символ
-            if (result == 1) {
-                if (!first) {
-                    putchar(' ');
-                }
-                encode(c1);
-                break;
-            }
+void put_str(const char *s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        out_buf[out_len++] = s[i];
+    }
+}
 
-            // если два символа считано
-            else {
-                if (c2 != ' ' && c2 != '\n') {
-                    if (!first) {
-                        printf(" ");
-                    }
-                    printf("n/a");
-                    return 1;
-                }
+// Дочитывает блок после перенесенного хвоста длиной carry. Возвращает сколько байт в буфере.
+size_t fill_buffer(size_t carry, int *eof) {
+    ssize_t n = read(STDIN_FILENO, in_buf + carry, READ_BUF_SIZE);
+    if (n <= 0) {
+        *eof = 1;
+        n = 0;
+    }
+    return carry + (size_t)n;
+}
 
-                if (!first) {
-                    putchar(' ');
-                }
-                encode(c1);
-                first = 0;
+void encode(unsigned char c) {
+    if (c == ' ') {
+        out_buf[out_len++] = ' ';
+    } else {
+        out_buf[out_len++] = hex_pair[c][0];
+        out_buf[out_len++] = hex_pair[c][1];
+    }
+}
 
-                if (c2 == '\n') {
-                    break;
-                }
-            }
-        }
-        // читаем HEX
-    } else if (*argv[1] == '1') {
-        char first, second, space;
-        int result;
+#ifdef __SSE2__
+/*
+    16 байт = 8 пар "символ + пробел". Пара "чистая", если разделитель - пробел,
+    а символ не пробел и не '\n'. Тогда все 8 пар кодируются без проверок.
+*/
+int is_clean_encode_block(const unsigned char *p) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    int spaces = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+    int newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    return (spaces & 0xAAAA) == 0xAAAA && ((spaces | newlines) & 0x5555) == 0;
+}
 
-        while (1) {
-            result = scanf("%c%c%c", &first, &second, &space);
+int hex_digit_mask(__m128i v) {
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                   _mm_cmplt_epi8(v, _mm_set1_epi8('F' + 1)));
+    return _mm_movemask_epi8(_mm_or_si128(digit, letter));
+}
 
-            if (first == '\n') {
-                break;
+// 48 байт = 16 троек "HH ". Позиции пробелов повторяются с периодом 3.
+int is_clean_decode_block(const unsigned char *p) {
+    const unsigned long long space_pos = 0x924924924924ULL;  // биты 2, 5, 8, ..., 47
+    const unsigned long long all = 0xFFFFFFFFFFFFULL;
+    unsigned long long spaces = 0, hex = 0;
+    for (int i = 0; i < 3; i++) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(p + 16 * i));
+        spaces |= (unsigned long long)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(' '))) << (16 * i);
+        hex |= (unsigned long long)hex_digit_mask(v) << (16 * i);
+    }
+    return (spaces & space_pos) == space_pos && (hex & (all & ~space_pos)) == (all & ~space_pos);
+}
+#endif
+
+/*
+    Кодирование: пары "символ + разделитель" до первого '\n'.
+    Разделитель не пробел и не '\n' - печатаем "n/a" и выходим с кодом 1.
+    Одиночный символ перед концом ввода кодируется как последний.
+*/
+int encode_stream(void) {
+    int first = 1, eof = 0, done = 0;
+    size_t carry = 0;
+
+    while (!done && !eof) {
+        size_t len = fill_buffer(carry, &eof);
+        size_t i = 0;
+
+        while (!done && len - i >= 2) {
+#ifdef __SSE2__
+            if (len - i >= 16 && is_clean_encode_block(in_buf + i)) {
+                for (int k = 0; k < 16; k += 2) {
+                    if (!first) out_buf[out_len++] = ' ';
+                    encode(in_buf[i + k]);
+                    first = 0;
+                }
+                i += 16;
+                continue;
             }
-
-            if (result < 3 || (space != ' ' && space != '\n')) {
-                printf("n/a");
+#endif
+            unsigned char c1 = in_buf[i], c2 = in_buf[i + 1];
+            i += 2;
+            if (c1 == '\n') {
+                done = 1;
+            } else if (c2 != ' ' && c2 != '\n') {
+                if (!first) out_buf[out_len++] = ' ';
+                put_str("n/a", 3);
+                flush_out();
                 return 1;
+            } else {
+                if (!first) out_buf[out_len++] = ' ';
+                encode(c1);
+                first = 0;
+                done = c2 == '\n';
             }
+        }
 
-            decode(first, second);
+        carry = done ? 0 : len - i;
+        if (carry) in_buf[0] = in_buf[i];
+        flush_out();
+    }
 
-            if (space == '\n') {
-                break;
-            }
-            putchar(' ');
-        }
-    } else {
-        printf("n/a");
-        return 1;
+    // Если только один символ был прочитан, это должен быть последний символ
+    if (!done && carry && in_buf[0] != '\n') {
+        if (!first) out_buf[out_len++] = ' ';
+        encode(in_buf[0]);
+        flush_out();
     }
     return 0;
 }
 
-void encode(char c) {
-    if (c == ' ') {
-        putchar(' ');
-    } else {
-        /*
-        %X выводит число в шестнадцатеричном формате.
-        0 заполняет ведущими нулями, если число меньше двух цифр.
-        2 указывает, что нужно вывести ровно две цифры.
-        */
-        printf("%02X", c);
+/*
+    Декодирование: тройки "HH" + разделитель до первого '\n'.
+    Плохой разделитель или обрыв ввода - "n/a" и код 1.
+    Не-hex цифра - "n/a" на месте символа, разбор продолжается.
+*/
+int decode_stream(void) {
+    int eof = 0, done = 0;
+    size_t carry = 0;
+
+    while (!done && !eof) {
+        size_t len = fill_buffer(carry, &eof);
+        size_t i = 0;
+
+        while (!done && len - i >= 3) {
+#ifdef __SSE2__
+            if (len - i >= 48 && is_clean_decode_block(in_buf + i)) {
+                for (int k = 0; k < 48; k += 3) {
+                    out_buf[out_len++] = (char)(hex_value[in_buf[i + k]] << 4 | hex_value[in_buf[i + k + 1]]);
+                    out_buf[out_len++] = ' ';
+                }
+                i += 48;
+                continue;
+            }
+#endif
+            unsigned char first = in_buf[i], second = in_buf[i + 1], space = in_buf[i + 2];
+            i += 3;
+            if (first == '\n') {
+                done = 1;
+            } else if (space != ' ' && space != '\n') {
+                put_str("n/a", 3);
+                flush_out();
+                return 1;
+            } else {
+                unsigned char h = hex_value[first], l = hex_value[second];
+                if (h == INVALID_HEX || l == INVALID_HEX) {
+                    put_str("n/a", 3);
+                } else {
+                    out_buf[out_len++] = (char)(h << 4 | l);
+                }
+                done = space == '\n';
+                if (!done) out_buf[out_len++] = ' ';
+            }
+        }
+
+        carry = done ? 0 : len - i;
+        for (size_t k = 0; k < carry; k++) {
+            in_buf[k] = in_buf[i + k];
+        }
+        flush_out();
     }
-}
 
-void decode(char first, char second) {
-    int h = char_to_int(first);
-    int l = char_to_int(second);
-    if (h == -1 || l == -1) {
+    if (!done && (carry == 0 || in_buf[0] != '\n')) {
         printf("n/a");
-        return;
+        return 1;
     }
-
-    printf("%c", h * 16 + l);
+    return 0;
 }
-
-int char_to_int(char c) {
-    // вычитаем код символа '0', чтобы получить цифру
-    if (c >= '0' && c <= '9') return c - '0';
-    // вычитаем 'A' и добавляем 10 - преобразуем буквы в их числовые значения
-    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
-    return -1;
-}
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "door_curves.h"
+
+#include <float.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define CHUNK_SAMPLES 65536  // Отсчетов на один кусок работы потока
+#define CHUNK_TEXT_GUESS 48  // Типичная длина строки таблицы, под нее выделяется буфер куска
+#define MAX_THREADS 64
+
+static const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/*
+    Формулы те же, что в исходных door_functions.c и door_functions_print.c, и порядок
+    операций сохранен, чтобы векторная и скалярная ветки давали побитово одинаковый результат.
+*/
+static void eval_scalar(LemniscateFormula lemniscate, double x, double *v, double *l, double *h) {
+    *v = 1.0 / (1.0 + x * x);
+    if (lemniscate == LEMNISCATE_PRINT) {
+        *l = (x < -1 || x > 1) ? CURVE_UNDEFINED : sqrt(sqrt(1 + 4 * x * x) - 1) / sqrt(2);
+    } else {
+        double temp = sqrt(sqrt(1 + 4 * x * x) * 1 - x * x - 1);
+        *l = (temp >= 0) ? temp : CURVE_UNDEFINED;
+    }
+    *h = (x != 0) ? 1.0 / (x * x) : CURVE_UNDEFINED;
+}
+
+void curves_eval(const CurveGrid *grid, long first, long count, double *x, double *v, double *l, double *h) {
+    double step = (grid->end - grid->start) / (grid->steps - 1);
+    long i = 0;
+
+#ifdef __SSE2__
+    const __m128d one = _mm_set1_pd(1.0), four = _mm_set1_pd(4.0), zero = _mm_setzero_pd();
+    const __m128d undefined = _mm_set1_pd(CURVE_UNDEFINED), start = _mm_set1_pd(grid->start);
+    const __m128d vstep = _mm_set1_pd(step), minus_one = _mm_set1_pd(-1.0), sqrt2 = _mm_set1_pd(sqrt(2));
+
+    for (; i + 2 <= count; i += 2) {
+        __m128d idx = _mm_set_pd((double)(first + i + 1), (double)(first + i));
+        __m128d vx = _mm_add_pd(start, _mm_mul_pd(idx, vstep));
+        __m128d xx = _mm_mul_pd(vx, vx);
+
+        __m128d vv = _mm_div_pd(one, _mm_add_pd(one, xx));
+
+        __m128d inner = _mm_sqrt_pd(_mm_add_pd(one, _mm_mul_pd(_mm_mul_pd(four, vx), vx)));
+        __m128d temp, l_ok;
+        if (grid->lemniscate == LEMNISCATE_PRINT) {
+            temp = _mm_div_pd(_mm_sqrt_pd(_mm_sub_pd(inner, one)), sqrt2);
+            l_ok = _mm_and_pd(_mm_cmpge_pd(vx, minus_one), _mm_cmple_pd(vx, one));
+        } else {
+            temp = _mm_sqrt_pd(_mm_sub_pd(_mm_sub_pd(_mm_mul_pd(inner, one), xx), one));
+            l_ok = _mm_cmpge_pd(temp, zero);  // NaN дает false, как и в скалярной версии
+        }
+        __m128d vl = _mm_or_pd(_mm_and_pd(l_ok, temp), _mm_andnot_pd(l_ok, undefined));
+
+        __m128d h_ok = _mm_cmpneq_pd(vx, zero);
+        __m128d vh = _mm_or_pd(_mm_and_pd(h_ok, _mm_div_pd(one, xx)), _mm_andnot_pd(h_ok, undefined));
+
+        _mm_storeu_pd(x + i, vx);
+        _mm_storeu_pd(v + i, vv);
+        _mm_storeu_pd(l + i, vl);
+        _mm_storeu_pd(h + i, vh);
+    }
+#endif
+    for (; i < count; i++) {
+        x[i] = grid->start + (first + i) * step;
+        eval_scalar(grid->lemniscate, x[i], &v[i], &l[i], &h[i]);
+    }
+}
+
+static size_t format_uint(char *buf, unsigned long long n) {
+    char tmp[24];
+    int pos = 24;
+    while (n >= 100) {
+        pos -= 2;
+        memcpy(tmp + pos, digit_pairs + (n % 100) * 2, 2);
+        n /= 100;
+    }
+    if (n >= 10) {
+        pos -= 2;
+        memcpy(tmp + pos, digit_pairs + n * 2, 2);
+    } else {
+        tmp[--pos] = (char)('0' + n);
+    }
+    memcpy(buf, tmp + pos, (size_t)(24 - pos));
+    return (size_t)(24 - pos);
+}
+
+/*
+    value * 10^7 округляется к ближайшему целому. Если дробная часть произведения
+    слишком близка к 0.5 и ошибка умножения может повлиять на округление, а также для
+    больших чисел и inf/nan отдаем работу snprintf - результат всегда совпадает с "%.7f".
+*/
+size_t format_fixed7(char *buf, double value) {
+    double a = fabs(value);
+    double scaled = a * 1e7;
+    double frac = scaled - floor(scaled);
+
+    if (!(a < 1e11) || fabs(frac - 0.5) <= 4 * DBL_EPSILON * scaled) {
+        return (size_t)snprintf(buf, FIXED7_MAX, "%.7f", value);
+    }
+
+    size_t len = 0;
+    unsigned long long r = (unsigned long long)nearbyint(scaled);
+    unsigned long long int_part = r / 10000000ULL, frac_part = r % 10000000ULL;
+
+    if (signbit(value)) buf[len++] = '-';
+    len += format_uint(buf + len, int_part);
+    buf[len++] = '.';
+    for (int i = 6; i >= 0; i--) {
+        buf[len + i] = (char)('0' + frac_part % 10);
+        frac_part /= 10;
+    }
+    return len + 7;
+}
+
+size_t format_row(char *buf, double x, double v, double l, double h) {
+    size_t len = format_fixed7(buf, x);
+    memcpy(buf + len, " | ", 3);
+    len += 3;
+    len += format_fixed7(buf + len, v);
+    memcpy(buf + len, " | ", 3);
+    len += 3;
+    if (l == CURVE_UNDEFINED) {
+        buf[len++] = '-';
+    } else {
+        len += format_fixed7(buf + len, l);
+    }
+    memcpy(buf + len, " | ", 3);
+    len += 3;
+    if (h == CURVE_UNDEFINED) {
+        buf[len++] = '-';
+    } else {
+        len += format_fixed7(buf + len, h);
+    }
+    return len;
+}
+
+typedef struct {
+    const CurveGrid *grid;
+    long first;
+    long count;
+    int binary;
+    double *x, *v, *l, *h;
+    char *out;
+    size_t out_len;
+    size_t out_cap;
+    int failed;
+} ChunkJob;
+
+static void *run_chunk(void *arg) {
+    ChunkJob *job = arg;
+    curves_eval(job->grid, job->first, job->count, job->x, job->v, job->l, job->h);
+
+    job->out_len = 0;
+    for (long i = 0; i < job->count; i++) {
+        if (job->binary) {
+            double row[4] = {job->x[i], job->v[i], job->l[i], job->h[i]};
+            memcpy(job->out + job->out_len, row, sizeof(row));
+            job->out_len += sizeof(row);
+        } else {
+            // Огромные значения гиперболы у нуля дают длинные строки - буфер растет
+            if (job->out_cap - job->out_len < CURVE_ROW_MAX) {
+                char *grown = realloc(job->out, job->out_cap * 2);
+                if (grown == NULL) {
+                    job->failed = 1;
+                    return NULL;
+                }
+                job->out = grown;
+                job->out_cap *= 2;
+            }
+            if (job->first + i > 0) job->out[job->out_len++] = '\n';
+            job->out_len += format_row(job->out + job->out_len, job->x[i], job->v[i], job->l[i], job->h[i]);
+        }
+    }
+    return NULL;
+}
+
+static int write_all(int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n <= 0) return 0;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 1;
+}
+
+/*
+    Сетка режется на куски по CHUNK_SAMPLES. За раунд каждый поток считает и
+    форматирует свой кусок в свой буфер, затем буферы пишутся в fd по порядку.
+*/
+int curves_write_table(const CurveGrid *grid, int threads, int binary, int trailing_newline, int fd) {
+    ChunkJob jobs[MAX_THREADS];
+    pthread_t tids[MAX_THREADS];
+    int started[MAX_THREADS];
+    int ok = 1;
+
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    for (int t = 0; t < threads; t++) {
+        jobs[t].grid = grid;
+        jobs[t].binary = binary;
+        jobs[t].x = malloc(4 * CHUNK_SAMPLES * sizeof(double));
+        jobs[t].failed = 0;
+        jobs[t].out_cap = binary ? 4 * CHUNK_SAMPLES * sizeof(double) : (size_t)CHUNK_SAMPLES * CHUNK_TEXT_GUESS;
+        jobs[t].out = malloc(jobs[t].out_cap);
+        if (jobs[t].x == NULL || jobs[t].out == NULL) ok = 0;
+        if (jobs[t].x != NULL) {
+            jobs[t].v = jobs[t].x + CHUNK_SAMPLES;
+            jobs[t].l = jobs[t].v + CHUNK_SAMPLES;
+            jobs[t].h = jobs[t].l + CHUNK_SAMPLES;
+        }
+    }
+
+    for (long first = 0; ok && first < grid->steps;) {
+        int used = 0;
+        for (; used < threads && first < grid->steps; used++) {
+            jobs[used].first = first;
+            jobs[used].count = grid->steps - first < CHUNK_SAMPLES ? grid->steps - first : CHUNK_SAMPLES;
+            first += jobs[used].count;
+        }
+
+        // Один кусок считаем в текущем потоке, чтобы не создавать поток зря
+        for (int t = 1; t < used; t++) {
+            started[t] = pthread_create(&tids[t], NULL, run_chunk, &jobs[t]) == 0;
+            if (!started[t]) run_chunk(&jobs[t]);
+        }
+        run_chunk(&jobs[0]);
+        for (int t = 1; t < used; t++) {
+            if (started[t]) pthread_join(tids[t], NULL);
+        }
+
+        for (int t = 0; t < used && ok; t++) {
+            ok = !jobs[t].failed && write_all(fd, jobs[t].out, jobs[t].out_len);
+        }
+    }
+
+    if (ok && trailing_newline && !binary) ok = write_all(fd, "\n", 1);
+
+    for (int t = 0; t < threads; t++) {
+        free(jobs[t].x);
+        free(jobs[t].out);
+    }
+    return ok;
+}
@@ -0,0 +1,41 @@
+#ifndef DOOR_CURVES_H
+#define DOOR_CURVES_H
+
+#include <stddef.h>
+
+/*
+    Общий генератор таблиц для door_functions.c и door_functions_print.c.
+    Сборка: gcc -O2 door_functions.c door_curves.c -lm -lpthread
+*/
+
+#define CURVE_UNDEFINED -1.0  // Значение функции там, где она не определена (в таблице "-")
+#define FIXED7_MAX 340        // "%.7f" для любого double, включая 1e308
+#define CURVE_ROW_MAX (4 * FIXED7_MAX + 16)  // Максимальная длина текстовой строки таблицы
+
+// Формула лемнискаты: у door_functions.c и door_functions_print.c они разные
+typedef enum {
+    LEMNISCATE_DOOR,   // sqrt(sqrt(1 + 4x^2) - x^2 - 1), door_functions.c
+    LEMNISCATE_PRINT,  // sqrt(sqrt(1 + 4x^2) - 1) / sqrt(2) при |x| <= 1, door_functions_print.c
+} LemniscateFormula;
+
+typedef struct {
+    double start;
+    double end;
+    long steps;  // Число отсчетов, включая оба конца интервала
+    LemniscateFormula lemniscate;
+} CurveGrid;
+
+// Отсчеты [first, first + count) сетки: абсцисса и три функции
+void curves_eval(const CurveGrid *grid, long first, long count, double *x, double *v, double *l, double *h);
+
+// "%.7f" без printf. Возвращает число записанных символов.
+size_t format_fixed7(char *buf, double value);
+
+// Строка таблицы "x | v | l | h" без перевода строки
+size_t format_row(char *buf, double x, double v, double l, double h);
+
+// Таблица целиком в fd: текст или, при binary, по 4 double на отсчет.
+// trailing_newline - ставить ли '\n' после последней строки текста.
+int curves_write_table(const CurveGrid *grid, int threads, int binary, int trailing_newline, int fd);
+
+#endif
@@ -1,47 +1,72 @@
-#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "door_curves.h"
 
 #define PI 3.14159265358979323846
 #define STEPS 42
 
-double verziera(double x) { return 1.0 / (1.0 + x * x); }
+/*
+    Без аргументов - таблица по заданию: 42 отсчета от -Пи до Пи.
+    door_functions [-b] [-t threads] [steps | start end steps]
+    -b - бинарный вывод: по 4 double (x, v, l, h) на отсчет, -1 там, где функция не определена.
+*/
 
-double lemniscate(double x) {
-    double temp = sqrt(sqrt(1 + 4 * x * x) * 1 - x * x - 1);
-    return (temp >= 0) ? temp : -1;
-}
+int parse_long(const char *s, long *out);
+int parse_double(const char *s, double *out);
+int parse_args(int argc, char *argv[], CurveGrid *grid, int *threads, int *binary);
 
-double hyperbola(double x) { return (x != 0) ? 1.0 / (x * x) : -1; }
+int main(int argc, char *argv[]) {
+    CurveGrid grid = {-PI, PI, STEPS, LEMNISCATE_DOOR};
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int binary = 0;
 
-int main() {
-    double start = -PI;
-    double end = PI;
-    double step = (end - start) / (STEPS - 1);
-    double x, v, l, h;
+    if (!parse_args(argc, argv, &grid, &threads, &binary)) {
+        printf("n/a");
+        return 1;
+    }
+    return curves_write_table(&grid, threads, binary, 0, STDOUT_FILENO) ? 0 : 1;
+}
 
-    for (int i = 0; i < STEPS; i++) {
-        x = start + i * step;
-        v = verziera(x);
-        l = lemniscate(x);
-        h = hyperbola(x);
+int parse_long(const char *s, long *out) {
+    char *end;
+    *out = strtol(s, &end, 10);
+    return *s != '\0' && *end == '\0';
+}
 
-        printf("%.7f | %.7f | ", x, v);
+int parse_double(const char *s, double *out) {
+    char *end;
+    *out = strtod(s, &end);
+    return *s != '\0' && *end == '\0';
+}
 
-        if (l == -1) {
-            printf("- | ");
-        } else {
-            printf("%.7f | ", l);
-        }
+int parse_args(int argc, char *argv[], CurveGrid *grid, int *threads, int *binary) {
+    const char *positional[3];
+    int count = 0, ok = 1;
 
-        if (h == -1) {
-            printf("-");
+    for (int i = 1; i < argc && ok; i++) {
+        long t;
+        if (strcmp(argv[i], "-b") == 0) {
+            *binary = 1;
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc && parse_long(argv[i + 1], &t) && t > 0) {
+            *threads = (int)t;
+            i++;
+        } else if (count < 3) {
+            positional[count++] = argv[i];
         } else {
-            printf("%.7f", h);
-        }
-        if (i != STEPS - 1) {
-            printf("\n");
+            ok = 0;
         }
     }
 
-    return 0;
-}
\ No newline at end of file
+    if (ok && count == 1) {
+        ok = parse_long(positional[0], &grid->steps);
+    } else if (ok && count == 3) {
+        ok = parse_double(positional[0], &grid->start) && parse_double(positional[1], &grid->end) &&
+             parse_long(positional[2], &grid->steps) && grid->start < grid->end;
+    } else if (count != 0) {
+        ok = 0;
+    }
+    return ok && grid->steps >= 2;
+}
@@ -1,5 +1,7 @@
-#include <math.h>
 #include <stdio.h>
+#include <unistd.h>
+
+#include "door_curves.h"
 
 #define PI 3.14159265358979323846
 #define STEPS 42
@@ -7,19 +9,6 @@
 #define PLOT_WIDTH 42
 char plot[PLOT_HEIGHT][PLOT_WIDTH];
 
-double verziera(double x) { return 1 / (1 + x * x); }
-
-double lemniscate(double x) {
-    if (x < -1 || x > 1) return -1;
-    double temp = sqrt(sqrt(1 + 4 * x * x) - 1) / sqrt(2);
-    return temp;
-}
-
-double hyperbola(double x) {
-    if (x == 0) return -1;
-    return 1 / (x * x);
-}
-
 void init_plot() {
     for (int i = 0; i < PLOT_HEIGHT; i++) {
         for (int j = 0; j < PLOT_WIDTH; j++) {
@@ -53,51 +42,33 @@ void display_plot() {
     }
 }
 
-void plot_function(double (*func)(double), char symbol, double min_y, double max_y) {
+// y - значения функции в PLOT_WIDTH отсчетах от -Пи до Пи
+void plot_function(const double *y, char symbol, double min_y, double max_y) {
     for (int i = 0; i < PLOT_WIDTH; i++) {
-        double x = -PI + (2 * PI * i) / (PLOT_WIDTH - 1);
-        double y = func(x);
-        if (y != -1 && y >= min_y && y <= max_y) {
-            int plot_y = (int)((PLOT_HEIGHT - 1) * (1 - (y - min_y) / (max_y - min_y)));
+        if (y[i] != CURVE_UNDEFINED && y[i] >= min_y && y[i] <= max_y) {
+            int plot_y = (int)((PLOT_HEIGHT - 1) * (1 - (y[i] - min_y) / (max_y - min_y)));
             plot_point(i, plot_y, symbol);
         }
     }
 }
 
 int main() {
-    double start = -PI;
-    double end = PI;
-    double step = (end - start) / (STEPS - 1);
-    double x, v, l, h;
+    CurveGrid table = {-PI, PI, STEPS, LEMNISCATE_PRINT};
+    CurveGrid axis = {-PI, PI, PLOT_WIDTH, LEMNISCATE_PRINT};
+    double x[PLOT_WIDTH], v[PLOT_WIDTH], l[PLOT_WIDTH], h[PLOT_WIDTH];
 
     if (1) {
         printf("\nТаблица:\n\n");
-        for (int i = 0; i < STEPS; i++) {
-            x = start + i * step;
-            v = verziera(x);
-            l = lemniscate(x);
-            h = hyperbola(x);
-            printf("%.7f | %.7f | ", x, v);
-
-            if (l == -1) {
-                printf("- | ");
-            } else {
-                printf("%.7f | ", l);
-            }
-
-            if (h == -1) {
-                printf("-\n");
-            } else {
-                printf("%.7f\n", h);
-            }
-        }
+        fflush(stdout);
+        curves_write_table(&table, 1, 0, 1, STDOUT_FILENO);
     }
 
     printf("\nГрафффиккк:\n\n");
     init_plot();
-    // plot_function(verziera, '*', 0, 1);
-    // plot_function(lemniscate, '+', 0, 1);
-    plot_function(hyperbola, '#', 0, 10);
+    curves_eval(&axis, 0, PLOT_WIDTH, x, v, l, h);
+    // plot_function(v, '*', 0, 1);
+    // plot_function(l, '+', 0, 1);
+    plot_function(h, '#', 0, 10);
     display_plot();
 
     return 0;
@@ -0,0 +1,8 @@
+#ifndef FLOOD_FILL_H
+# define FLOOD_FILL_H
+
+# include "flood_fill.t_point.h"
+
+void	flood_fill(char **tab, t_point size, t_point begin);
+
+#endif
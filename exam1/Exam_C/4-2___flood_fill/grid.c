@@ -0,0 +1,41 @@
+#include <limits.h>
+#include <stdlib.h>
+#include "grid.h"
+
+/*
+** Labels store a cell index + 1 in an int, so the map must stay below
+** INT_MAX cells.
+*/
+t_grid	*grid_new(int w, int h)
+{
+	t_grid	*g;
+	int		y;
+
+	if (w <= 0 || h <= 0 || (long long)w * h >= INT_MAX)
+		return (NULL);
+	g = malloc(sizeof(t_grid));
+	if (!g)
+		return (NULL);
+	g->w = w;
+	g->h = h;
+	g->cells = malloc((size_t)w * h);
+	g->rows = malloc(sizeof(char *) * h);
+	if (!g->cells || !g->rows)
+	{
+		grid_free(g);
+		return (NULL);
+	}
+	y = -1;
+	while (++y < h)
+		g->rows[y] = g->cells + (size_t)y * w;
+	return (g);
+}
+
+void	grid_free(t_grid *g)
+{
+	if (!g)
+		return ;
+	free(g->cells);
+	free(g->rows);
+	free(g);
+}
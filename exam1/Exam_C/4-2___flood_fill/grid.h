@@ -0,0 +1,59 @@
+#ifndef GRID_H
+# define GRID_H
+
+# include "flood_fill.t_point.h"
+
+/*
+** A rectangular map of chars. cells is one contiguous row-major buffer of
+** w * h chars and rows[y] points at the start of row y inside it, so the
+** same grid can be walked as a char ** (the exam API) or as a flat array
+** (the labeler). A grid built around someone else's char ** has no cells.
+*/
+typedef struct	s_grid
+{
+	int			w;
+	int			h;
+	char		*cells;
+	char		**rows;
+}				t_grid;
+
+# define GRID_MAX_THREADS 64
+
+t_grid			*grid_new(int w, int h);
+void			grid_free(t_grid *g);
+
+/*
+** Replaces the 4-connected zone of equal chars around begin with color.
+** Iterative scanline fill: the explicit segment stack lives on the heap,
+** so the depth does not depend on the map. Returns 0 if it ran out of
+** memory (the zone is then partially filled), 1 otherwise.
+*/
+int				grid_fill(const t_grid *g, t_point begin, char color);
+
+/*
+** Connected-component labeling of the cells equal to fg (4-connectivity).
+** labels must hold w * h ints; background gets 0 and the components get
+** 1..n numbered in the order they first appear in the map (row by row).
+** Returns n. Needs g->cells.
+*/
+int				grid_label(const t_grid *g, char fg, int *labels);
+
+/*
+** Same result as grid_label, computed by up to threads workers on
+** horizontal bands of the map that are merged along their borders.
+*/
+int				grid_label_tiles(const t_grid *g, char fg, int *labels,
+					int threads);
+
+/*
+** Union-find over labels, shared by both labelers. A provisional label is
+** the index of the parent cell + 1 and a root points to itself. Parents
+** always have a smaller index, so the root of a component is its first
+** cell in row order.
+*/
+int				grid_label_band(const t_grid *g, char fg, int *labels,
+					int y0, int y1);
+int				grid_uf_find(int *labels, int i);
+int				grid_uf_union(int *labels, int a, int b);
+
+#endif
@@ -0,0 +1,108 @@
+#include <stdlib.h>
+#include "grid.h"
+
+/*
+** Row y still has to be scanned between x1 and x2; it was reached from row
+** y - dy.
+*/
+typedef struct	s_seg
+{
+	int			y;
+	int			x1;
+	int			x2;
+	int			dy;
+}				t_seg;
+
+typedef struct	s_fill
+{
+	const t_grid	*g;
+	char			old;
+	char			color;
+	t_seg			*stack;
+	int				top;
+	int				cap;
+}				t_fill;
+
+static int	push(t_fill *f, t_seg s)
+{
+	t_seg	*grown;
+	int		i;
+
+	if (s.y < 0 || s.y >= f->g->h)
+		return (1);
+	if (f->top == f->cap)
+	{
+		grown = malloc(sizeof(t_seg) * f->cap * 2);
+		if (!grown)
+			return (0);
+		i = -1;
+		while (++i < f->top)
+			grown[i] = f->stack[i];
+		free(f->stack);
+		f->stack = grown;
+		f->cap *= 2;
+	}
+	f->stack[f->top++] = s;
+	return (1);
+}
+
+/*
+** Fills every run of old cells that touches [x1, x2], extending it past
+** both ends. The next row gets the whole run; the row we came from only
+** gets the parts that stick out of [x1, x2], the rest of it is done.
+*/
+static int	scan(t_fill *f, t_seg s)
+{
+	char	*row;
+	int		x;
+	int		l;
+
+	row = f->g->rows[s.y];
+	x = s.x1;
+	while (x <= s.x2)
+	{
+		while (x <= s.x2 && row[x] != f->old)
+			x++;
+		if (x > s.x2)
+			break ;
+		l = x;
+		while (l > 0 && row[l - 1] == f->old)
+			l--;
+		x = l;
+		while (x < f->g->w && row[x] == f->old)
+			row[x++] = f->color;
+		if (!push(f, (t_seg){s.y + s.dy, l, x - 1, s.dy})
+			|| (l < s.x1 && !push(f, (t_seg){s.y - s.dy, l, s.x1 - 1, -s.dy}))
+			|| (x - 1 > s.x2
+				&& !push(f, (t_seg){s.y - s.dy, s.x2 + 1, x - 1, -s.dy})))
+			return (0);
+	}
+	return (1);
+}
+
+int	grid_fill(const t_grid *g, t_point begin, char color)
+{
+	t_fill	f;
+	int		ok;
+
+	if (begin.x < 0 || begin.x >= g->w || begin.y < 0 || begin.y >= g->h
+		|| g->rows[begin.y][begin.x] == color)
+		return (1);
+	f.g = g;
+	f.old = g->rows[begin.y][begin.x];
+	f.color = color;
+	f.top = 0;
+	f.cap = 64;
+	f.stack = malloc(sizeof(t_seg) * f.cap);
+	if (!f.stack)
+		return (0);
+	ok = push(&f, (t_seg){begin.y, begin.x, begin.x, 1})
+		&& push(&f, (t_seg){begin.y - 1, begin.x, begin.x, -1});
+	while (ok && f.top > 0)
+	{
+		f.top--;
+		ok = scan(&f, f.stack[f.top]);
+	}
+	free(f.stack);
+	return (ok);
+}
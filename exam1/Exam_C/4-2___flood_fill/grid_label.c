@@ -0,0 +1,154 @@
+#include "grid.h"
+
+/*
+** What the row labeling needs besides the rows themselves, copied out of
+** the grid so that the compiler does not reload it after every store.
+*/
+typedef struct	s_row
+{
+	int			w;
+	char		fg;
+	int			first;
+	int			*labels;
+}				t_row;
+
+/*
+** Path halving: every visited cell is re-pointed to its grandparent.
+*/
+int	grid_uf_find(int *labels, int i)
+{
+	while (labels[i] - 1 != i)
+	{
+		labels[i] = labels[labels[i] - 1];
+		i = labels[i] - 1;
+	}
+	return (i);
+}
+
+/*
+** The larger root goes under the smaller one, so a root stays the first
+** cell of its component. Returns the root that was absorbed, or -1 if a
+** and b were already in the same component.
+*/
+int	grid_uf_union(int *labels, int a, int b)
+{
+	a = grid_uf_find(labels, a);
+	b = grid_uf_find(labels, b);
+	if (a < b)
+		labels[b] = a + 1;
+	else if (b < a)
+		labels[a] = b + 1;
+	if (a == b)
+		return (-1);
+	if (a < b)
+		return (b);
+	return (a);
+}
+
+/*
+** Labels the run of foreground cells [a, b) of a row. The run joins the
+** component of the first run above that it touches (or starts its own)
+** and is united with every other run above that it touches. up is NULL
+** on the first row of a band. Returns the change in the number of roots.
+*/
+static int	label_run(const char *up, int *lab, t_row r, int a, int b)
+{
+	int	roots;
+	int	v;
+	int	x;
+
+	roots = 1;
+	v = r.first + a + 1;
+	x = a;
+	while (up && x < b && up[x] != r.fg)
+		x++;
+	if (up && x < b)
+	{
+		roots = 0;
+		v = lab[x - r.w];
+		while (++x < b)
+			if (up[x] == r.fg && up[x - 1] != r.fg
+				&& grid_uf_union(r.labels, v - 1, r.first + x - r.w) >= 0)
+				roots--;
+	}
+	x = a - 1;
+	while (++x < b)
+		lab[x] = v;
+	return (roots);
+}
+
+/*
+** Works run by run rather than cell by cell: inside a run there is
+** nothing to decide, so the inner loops are plain scans and fills.
+*/
+static int	label_row(const char *row, const char *up, int *lab, t_row r)
+{
+	int	roots;
+	int	a;
+	int	x;
+
+	roots = 0;
+	x = 0;
+	while (x < r.w)
+	{
+		while (x < r.w && row[x] != r.fg)
+			lab[x++] = 0;
+		a = x;
+		while (x < r.w && row[x] == r.fg)
+			x++;
+		if (a < x)
+			roots += label_run(up, lab, r, a, x);
+	}
+	return (roots);
+}
+
+/*
+** Provisional labels for rows [y0, y1). The band does not look above y0,
+** so bands can be labeled independently and merged afterwards. Returns
+** the number of roots left in the band.
+*/
+int	grid_label_band(const t_grid *g, char fg, int *labels, int y0, int y1)
+{
+	t_row	r;
+	int		roots;
+	int		y;
+
+	r.w = g->w;
+	r.fg = fg;
+	r.labels = labels;
+	roots = 0;
+	y = y0 - 1;
+	while (++y < y1)
+	{
+		r.first = y * r.w;
+		roots += label_row(g->cells + r.first,
+				y > y0 ? g->cells + r.first - r.w : 0, labels + r.first, r);
+	}
+	return (roots);
+}
+
+/*
+** The parent of a cell always has a smaller index, so by the time a cell
+** is reached its parent already holds its final label.
+*/
+int	grid_label(const t_grid *g, char fg, int *labels)
+{
+	int	n;
+	int	i;
+	int	end;
+
+	grid_label_band(g, fg, labels, 0, g->h);
+	n = 0;
+	i = -1;
+	end = g->w * g->h;
+	while (++i < end)
+	{
+		if (labels[i] == 0)
+			continue ;
+		if (labels[i] - 1 == i)
+			labels[i] = ++n;
+		else
+			labels[i] = labels[labels[i] - 1];
+	}
+	return (n);
+}
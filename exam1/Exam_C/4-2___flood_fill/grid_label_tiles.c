@@ -0,0 +1,199 @@
+#include <pthread.h>
+#include "grid.h"
+
+/*
+** Labeling in bands of rows, one per worker:
+** 1. each worker labels its band on its own (grid_label_band) and counts
+**    the roots it made;
+** 2. the main thread unions the cells across every band border, taking
+**    each absorbed root off its band's count, and turns the counts into
+**    the first label of every band;
+** 3. each worker gives its cells their final label, stored negated to
+**    tell it from a parent index. A cell whose root lies in an earlier
+**    band that has not been numbered yet is pointed at that root instead;
+** 4. each worker flips its labels back and finishes those cells.
+** Roots are the first cell of a component in row order and bands are in
+** row order, so the numbering matches grid_label.
+** In steps 3 and 4 a worker reads cells of earlier bands while their
+** owner rewrites them; every value it can see leads to the right label,
+** the accesses are atomic so that this is well defined.
+*/
+typedef struct	s_tiles
+{
+	const t_grid	*g;
+	char			fg;
+	int				*labels;
+	int				first[GRID_MAX_THREADS];
+}				t_tiles;
+
+typedef struct	s_band
+{
+	t_tiles		*t;
+	int			id;
+	int			begin;
+	int			end;
+}				t_band;
+
+static int	load(int *p)
+{
+	return (__atomic_load_n(p, __ATOMIC_RELAXED));
+}
+
+static void	*label_band(void *arg)
+{
+	t_band	*b;
+
+	b = arg;
+	b->t->first[b->id] = grid_label_band(b->t->g, b->t->fg, b->t->labels,
+			b->begin / b->t->g->w, b->end / b->t->g->w);
+	return (NULL);
+}
+
+static void	*resolve(void *arg)
+{
+	t_band	*b;
+	int		*lab;
+	int		n;
+	int		i;
+	int		v;
+	int		next;
+
+	b = arg;
+	lab = b->t->labels;
+	n = b->t->first[b->id];
+	i = b->begin - 1;
+	while (++i < b->end)
+	{
+		v = lab[i];
+		if (v == 0)
+			continue ;
+		if (v - 1 == i)
+			v = -(++n);
+		while (v > 0)
+		{
+			next = load(&lab[v - 1]);
+			if (next == v)
+				break ;
+			v = next;
+		}
+		__atomic_store_n(&lab[i], v, __ATOMIC_RELAXED);
+	}
+	return (NULL);
+}
+
+static void	*finish(void *arg)
+{
+	t_band	*b;
+	int		*lab;
+	int		i;
+	int		v;
+
+	b = arg;
+	lab = b->t->labels;
+	i = b->begin - 1;
+	while (++i < b->end)
+	{
+		v = lab[i];
+		if (v > 0)
+			v = load(&lab[v - 1]);
+		if (v < 0)
+			v = -v;
+		__atomic_store_n(&lab[i], v, __ATOMIC_RELAXED);
+	}
+	return (NULL);
+}
+
+/*
+** Runs fn on every band. A band whose thread cannot be started runs on the
+** calling thread instead.
+*/
+static void	run(t_band *bands, int n, void *(*fn)(void *))
+{
+	pthread_t	tids[GRID_MAX_THREADS];
+	int			started[GRID_MAX_THREADS];
+	int			i;
+
+	i = -1;
+	while (++i < n)
+	{
+		started[i] = pthread_create(&tids[i], NULL, fn, &bands[i]) == 0;
+		if (!started[i])
+			fn(&bands[i]);
+	}
+	while (--i >= 0)
+		if (started[i])
+			pthread_join(tids[i], NULL);
+}
+
+static int	band_of(const t_band *bands, int cell)
+{
+	int	k;
+
+	k = 0;
+	while (bands[k].end <= cell)
+		k++;
+	return (k);
+}
+
+/*
+** Returns the number of components.
+*/
+static int	merge_borders(t_tiles *t, const t_band *bands, int n)
+{
+	const char	*c;
+	int			count;
+	int			root;
+	int			i;
+	int			k;
+
+	c = t->g->cells;
+	k = 0;
+	while (++k < n)
+	{
+		i = bands[k].begin - 1;
+		while (++i < bands[k].begin + t->g->w)
+		{
+			if (c[i] != t->fg || c[i - t->g->w] != t->fg)
+				continue ;
+			root = grid_uf_union(t->labels, i - t->g->w, i);
+			if (root >= 0)
+				t->first[band_of(bands, root)]--;
+		}
+	}
+	count = 0;
+	k = -1;
+	while (++k < n)
+	{
+		root = t->first[k];
+		t->first[k] = count;
+		count += root;
+	}
+	return (count);
+}
+
+int	grid_label_tiles(const t_grid *g, char fg, int *labels, int threads)
+{
+	t_tiles	t;
+	t_band	bands[GRID_MAX_THREADS];
+	int		count;
+	int		k;
+
+	if (threads > GRID_MAX_THREADS)
+		threads = GRID_MAX_THREADS;
+	if (threads > g->h)
+		threads = g->h;
+	if (threads <= 1)
+		return (grid_label(g, fg, labels));
+	t.g = g;
+	t.fg = fg;
+	t.labels = labels;
+	k = -1;
+	while (++k < threads)
+		bands[k] = (t_band){&t, k, g->h * (long long)k / threads * g->w,
+			g->h * (long long)(k + 1) / threads * g->w};
+	run(bands, threads, label_band);
+	count = merge_borders(&t, bands, threads);
+	run(bands, threads, resolve);
+	run(bands, threads, finish);
+	return (count);
+}
@@ -0,0 +1,66 @@
+#ifndef BF_H
+# define BF_H
+
+/*
+** The subject's tape is 2048 bytes; bigger programs can be built with
+** -D BF_TAPE_SIZE=30000.
+*/
+# ifndef BF_TAPE_SIZE
+#  define BF_TAPE_SIZE 2048
+# endif
+
+# define BF_OUT_SIZE 4096
+
+/*
+** One instruction of the compiled program. off is relative to the current
+** cell: moves between two loops are not executed, they only shift the
+** offsets of the instructions that follow them.
+**   BF_ADD    tape[p + off] += arg
+**   BF_MOVE   p += arg
+**   BF_OUT    write tape[p + off], arg times
+**   BF_JZ     if tape[p] == 0, continue at ops[arg] (after the loop)
+**   BF_JNZ    if tape[p] != 0, continue at ops[arg] (the loop body)
+**   BF_CLEAR  tape[p + off] = 0                       [-]
+**   BF_MUL    tape[p + off] += tape[p] * arg          [->+++>+<<]
+**   BF_SCAN   move by arg until tape[p] == 0          [>>]
+*/
+typedef enum	e_bf_kind
+{
+	BF_ADD,
+	BF_MOVE,
+	BF_OUT,
+	BF_JZ,
+	BF_JNZ,
+	BF_CLEAR,
+	BF_MUL,
+	BF_SCAN,
+	BF_END
+}				t_bf_kind;
+
+typedef struct	s_bf_op
+{
+	int				off;
+	int				arg;
+	unsigned char	kind;
+}				t_bf_op;
+
+typedef struct	s_bf_prog
+{
+	t_bf_op		*ops;
+	int			len;
+}				t_bf_prog;
+
+/*
+** Compiles src (brackets must match). Returns NULL if they do not or if
+** memory runs out.
+*/
+t_bf_prog		*bf_compile(const char *src);
+void			bf_free(t_bf_prog *prog);
+
+/*
+** Runs prog on a fresh zeroed tape, writing its output to fd. Returns 0,
+** or -1 if a write failed or memory ran out.
+*/
+int				bf_run(const t_bf_prog *prog, int fd);
+
+#endif
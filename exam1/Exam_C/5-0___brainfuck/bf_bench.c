@@ -0,0 +1,135 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "bf.h"
+
+/*
+** Benchmark of the engine against the interpreter the subject describes:
+** one source char at a time, brackets matched by scanning the source.
+** Its output is buffered like the engine's, so that only interpretation
+** is compared, not write calls. Both write to /dev/null; the outputs are
+** compared once beforehand.
+**   bf_bench program.b [runs]
+*/
+
+static void	naive(const char *src, int fd)
+{
+	unsigned char	tape[BF_TAPE_SIZE] = {0};
+	unsigned char	buf[BF_OUT_SIZE];
+	unsigned char	*p;
+	int				depth;
+	int				len;
+
+	p = tape;
+	len = 0;
+	for (; *src; src++)
+	{
+		if (*src == '>')
+			p++;
+		else if (*src == '<')
+			p--;
+		else if (*src == '+')
+			(*p)++;
+		else if (*src == '-')
+			(*p)--;
+		else if (*src == '.' && len == BF_OUT_SIZE)
+		{
+			write(fd, buf, len);
+			buf[0] = *p;
+			len = 1;
+		}
+		else if (*src == '.')
+			buf[len++] = *p;
+		else if (*src == '[' && !*p)
+			for (depth = 1; depth; depth += (*src == '[') - (*src == ']'))
+				src++;
+		else if (*src == ']' && *p)
+			for (depth = 1; depth; depth += (*src == ']') - (*src == '['))
+				src--;
+	}
+	write(fd, buf, len);
+}
+
+static char	*read_file(const char *path)
+{
+	char	*src;
+	int		fd;
+	long	len;
+	long	got;
+
+	fd = open(path, O_RDONLY);
+	len = fd < 0 ? -1 : lseek(fd, 0, SEEK_END);
+	src = len < 0 ? NULL : malloc(len + 1);
+	if (src && lseek(fd, 0, SEEK_SET) == 0)
+		for (got = 0; got < len; got += read(fd, src + got, len - got))
+			;
+	if (src)
+		src[len] = '\0';
+	if (fd >= 0)
+		close(fd);
+	return (src);
+}
+
+static double	now(void)
+{
+	struct timespec	t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (t.tv_sec + t.tv_nsec * 1e-9);
+}
+
+static int	same_output(const char *src, const t_bf_prog *prog)
+{
+	FILE	*a;
+	FILE	*b;
+	int		ca;
+	int		cb;
+
+	a = tmpfile();
+	b = tmpfile();
+	naive(src, fileno(a));
+	bf_run(prog, fileno(b));
+	rewind(a);
+	rewind(b);
+	do
+	{
+		ca = fgetc(a);
+		cb = fgetc(b);
+	} while (ca == cb && ca != EOF);
+	fclose(a);
+	fclose(b);
+	return (ca == cb);
+}
+
+int	main(int argc, char **argv)
+{
+	t_bf_prog	*prog;
+	char		*src;
+	int			runs;
+	int			null;
+	double		t[3];
+
+	src = argc > 1 ? read_file(argv[1]) : NULL;
+	prog = src ? bf_compile(src) : NULL;
+	if (!prog)
+		return (fprintf(stderr, "usage: bf_bench program.b [runs]\n"), 1);
+	runs = argc > 2 ? atoi(argv[2]) : 1;
+	null = open("/dev/null", O_WRONLY);
+	if (!same_output(src, prog))
+		return (fprintf(stderr, "%s: outputs differ\n", argv[1]), 1);
+	t[0] = now();
+	for (int i = 0; i < runs; i++)
+		naive(src, null);
+	t[1] = now();
+	for (int i = 0; i < runs; i++)
+		bf_run(prog, null);
+	t[2] = now();
+	printf("%s: %d ops, naive %.3f s, engine %.3f s, x%.1f\n", argv[1],
+		prog->len, (t[1] - t[0]) / runs, (t[2] - t[1]) / runs,
+		(t[1] - t[0]) / (t[2] - t[1]));
+	bf_free(prog);
+	free(src);
+	return (0);
+}
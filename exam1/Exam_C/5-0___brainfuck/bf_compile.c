@@ -0,0 +1,231 @@
+#include <stdlib.h>
+#include "bf.h"
+
+/*
+** The source folded into runs: '+' and '-' become one BF_ADD, '<' and '>'
+** one BF_MOVE, '.' one BF_OUT; '[' and ']' are BF_JZ and BF_JNZ with arg
+** pointing at the matching bracket.
+*/
+typedef struct	s_tokens
+{
+	t_bf_op		*t;
+	int			len;
+}				t_tokens;
+
+typedef struct	s_emit
+{
+	t_bf_op		*ops;
+	int			len;
+	int			pending;
+	int			*open;
+	int			depth;
+}				t_emit;
+
+static int	token_kind(char c)
+{
+	if (c == '+' || c == '-')
+		return (BF_ADD);
+	if (c == '<' || c == '>')
+		return (BF_MOVE);
+	if (c == '.')
+		return (BF_OUT);
+	if (c == '[')
+		return (BF_JZ);
+	if (c == ']')
+		return (BF_JNZ);
+	return (-1);
+}
+
+static int	tokenize(const char *src, t_tokens *tk, int *stack)
+{
+	int	kind;
+	int	depth;
+
+	depth = 0;
+	tk->len = 0;
+	while (*src)
+	{
+		kind = token_kind(*src);
+		if (kind >= 0 && (kind >= BF_JZ || tk->len == 0
+				|| tk->t[tk->len - 1].kind != kind))
+			tk->t[tk->len++] = (t_bf_op){0, 0, kind};
+		if (kind == BF_ADD || kind == BF_MOVE)
+			tk->t[tk->len - 1].arg += (*src == '+' || *src == '>') ? 1 : -1;
+		else if (kind == BF_OUT)
+			tk->t[tk->len - 1].arg++;
+		else if (kind == BF_JZ)
+			stack[depth++] = tk->len - 1;
+		else if (kind == BF_JNZ && depth == 0)
+			return (0);
+		else if (kind == BF_JNZ)
+		{
+			tk->t[tk->len - 1].arg = stack[--depth];
+			tk->t[stack[depth]].arg = tk->len - 1;
+		}
+		src++;
+	}
+	return (depth == 0);
+}
+
+/*
+** The products are guarded by a BF_JZ: a loop that is not entered must
+** not touch its other cells, they can lie outside the tape.
+*/
+static void	emit_mul(t_emit *e, const int *offs, const int *deltas, int n)
+{
+	int	jz;
+	int	i;
+
+	if (e->pending)
+		e->ops[e->len++] = (t_bf_op){0, e->pending, BF_MOVE};
+	e->pending = 0;
+	jz = e->len++;
+	i = 0;
+	while (++i < n)
+		if (deltas[i] & 255)
+			e->ops[e->len++] = (t_bf_op){offs[i],
+				((deltas[0] & 255) == 255 ? deltas[i] : -deltas[i]), BF_MUL};
+	e->ops[jz] = (t_bf_op){0, e->len + 1, BF_JZ};
+}
+
+/*
+** A loop whose body only adds and moves, ends where it started and
+** changes its own cell by exactly -1 or +1 runs tape[p] (or 256 - tape[p])
+** times: every other cell it touches gets that count times its delta.
+** A body that is a single move is a scan. Returns 1 if the loop at
+** tokens [a, b] was replaced.
+*/
+static int	emit_idiom(t_emit *e, const t_bf_op *t, int a, int b)
+{
+	int	offs[16];
+	int	deltas[16];
+	int	n;
+	int	pos;
+	int	i;
+
+	if (b == a + 2 && t[a + 1].kind == BF_MOVE)
+	{
+		if (e->pending)
+			e->ops[e->len++] = (t_bf_op){0, e->pending, BF_MOVE};
+		e->pending = 0;
+		e->ops[e->len++] = (t_bf_op){0, t[a + 1].arg, BF_SCAN};
+		return (1);
+	}
+	n = 1;
+	offs[0] = 0;
+	deltas[0] = 0;
+	pos = 0;
+	while (++a < b)
+	{
+		if (t[a].kind == BF_MOVE)
+			pos += t[a].arg;
+		else if (t[a].kind != BF_ADD)
+			return (0);
+		else
+		{
+			i = 0;
+			while (i < n && offs[i] != pos)
+				i++;
+			if (i == 16)
+				return (0);
+			if (i == n)
+			{
+				offs[n] = pos;
+				deltas[n++] = 0;
+			}
+			deltas[i] += t[a].arg;
+		}
+	}
+	if (pos != 0 || ((deltas[0] & 255) != 255 && (deltas[0] & 255) != 1))
+		return (0);
+	if (n > 1)
+		emit_mul(e, offs, deltas, n);
+	e->ops[e->len++] = (t_bf_op){e->pending, 0, BF_CLEAR};
+	return (1);
+}
+
+static void	emit(t_emit *e, const t_tokens *tk)
+{
+	const t_bf_op	*t;
+	int				i;
+
+	t = tk->t;
+	i = -1;
+	while (++i < tk->len)
+	{
+		if (t[i].kind == BF_JZ && emit_idiom(e, t, i, t[i].arg))
+			i = t[i].arg;
+		else if (t[i].kind == BF_MOVE)
+			e->pending += t[i].arg;
+		else if (t[i].kind == BF_ADD || t[i].kind == BF_OUT)
+			e->ops[e->len++] = (t_bf_op){e->pending, t[i].arg, t[i].kind};
+		else
+		{
+			if (e->pending)
+				e->ops[e->len++] = (t_bf_op){0, e->pending, BF_MOVE};
+			e->pending = 0;
+			if (t[i].kind == BF_JZ)
+				e->open[e->depth++] = e->len;
+			else
+			{
+				e->ops[e->open[--e->depth]].arg = e->len + 1;
+				e->ops[e->len].arg = e->open[e->depth] + 1;
+			}
+			e->ops[e->len++].kind = t[i].kind;
+		}
+	}
+	e->ops[e->len++] = (t_bf_op){0, 0, BF_END};
+}
+
+static int	source_length(const char *src)
+{
+	int	len;
+
+	len = 0;
+	while (src[len])
+		len++;
+	return (len);
+}
+
+/*
+** Every source char makes at most one token, and every token at most one
+** op, except a move before a bracket or an idiom and the guard of a
+** multiply loop (one more op each).
+*/
+t_bf_prog	*bf_compile(const char *src)
+{
+	t_bf_prog	*prog;
+	t_tokens	tk;
+	t_emit		e;
+	int			n;
+
+	n = source_length(src);
+	prog = malloc(sizeof(t_bf_prog));
+	tk.t = malloc(sizeof(t_bf_op) * (n + 1));
+	e.ops = malloc(sizeof(t_bf_op) * (2 * n + 1));
+	e.open = malloc(sizeof(int) * (n + 1));
+	e.len = 0;
+	e.pending = 0;
+	e.depth = 0;
+	if (prog && tk.t && e.ops && e.open && tokenize(src, &tk, e.open))
+		emit(&e, &tk);
+	free(tk.t);
+	free(e.open);
+	if (!prog || e.len == 0)
+	{
+		free(prog);
+		free(e.ops);
+		return (NULL);
+	}
+	prog->ops = e.ops;
+	prog->len = e.len;
+	return (prog);
+}
+
+void	bf_free(t_bf_prog *prog)
+{
+	if (!prog)
+		return ;
+	free(prog->ops);
+	free(prog);
+}
@@ -0,0 +1,162 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include "bf.h"
+
+typedef struct	s_out
+{
+	int				fd;
+	int				len;
+	int				failed;
+	char			buf[BF_OUT_SIZE];
+}				t_out;
+
+static void	flush(t_out *out)
+{
+	if (out->len > 0 && write(out->fd, out->buf, out->len) != out->len)
+		out->failed = 1;
+	out->len = 0;
+}
+
+static void	put(t_out *out, unsigned char c, int times)
+{
+	while (times-- > 0)
+	{
+		if (out->len == BF_OUT_SIZE)
+			flush(out);
+		out->buf[out->len++] = c;
+	}
+}
+
+/*
+** Eight cells as one word. Compilers turn the loop into a single load; the
+** byte order does not matter to the zero test.
+*/
+static unsigned long long	load8(const unsigned char *p)
+{
+	unsigned long long	w;
+	int					k;
+
+	w = 0;
+	k = 8;
+	while (k-- > 0)
+		w = w << 8 | p[k];
+	return (w);
+}
+
+/*
+** Looks for a zero byte 8 cells at a time: (w - 0x01..01) & ~w & 0x80..80
+** is non-zero exactly when one of the bytes of w is zero. The scan stops
+** at the ends of the tape.
+*/
+static int	scan(const unsigned char *tape, int i, int step)
+{
+	unsigned long long	w;
+
+	while (step == 1 && i + 8 <= BF_TAPE_SIZE)
+	{
+		w = load8(tape + i);
+		if ((w - 0x0101010101010101ULL) & ~w & 0x8080808080808080ULL)
+			break ;
+		i += 8;
+	}
+	while (step == -1 && i - 7 >= 0)
+	{
+		w = load8(tape + i - 7);
+		if ((w - 0x0101010101010101ULL) & ~w & 0x8080808080808080ULL)
+			break ;
+		i -= 8;
+	}
+	while (tape[i] && i + step >= 0 && i + step < BF_TAPE_SIZE)
+		i += step;
+	return (i);
+}
+
+/*
+** Threaded dispatch: every handler ends with its own indirect jump to the
+** next one, so the branch predictor sees one jump per handler instead of
+** the single shared jump of a switch. Other compilers get the switch.
+*/
+#ifdef __GNUC__
+# define CASE(k) L_##k:
+# define NEXT goto *g_jump[(++ip)->kind]
+# define DISPATCH goto *g_jump[ip->kind];
+#else
+# define CASE(k) case k:
+# define NEXT break
+# define DISPATCH for (;; ++ip) switch (ip->kind) {
+#endif
+
+static void	execute(const t_bf_op *ops, unsigned char *tape, t_out *out)
+{
+	const t_bf_op	*ip;
+	unsigned char	*p;
+
+#ifdef __GNUC__
+	static const void	*g_jump[] = {&&L_BF_ADD, &&L_BF_MOVE, &&L_BF_OUT,
+		&&L_BF_JZ, &&L_BF_JNZ, &&L_BF_CLEAR, &&L_BF_MUL, &&L_BF_SCAN,
+		&&L_BF_END};
+#endif
+
+	ip = ops;
+	p = tape;
+	DISPATCH
+	CASE(BF_ADD)
+		p[ip->off] += ip->arg;
+		NEXT;
+	CASE(BF_MOVE)
+		p += ip->arg;
+		NEXT;
+	CASE(BF_OUT)
+		put(out, p[ip->off], ip->arg);
+		NEXT;
+	CASE(BF_JZ)
+		if (!*p)
+			ip = ops + ip->arg - 1;
+		NEXT;
+	CASE(BF_JNZ)
+		if (*p)
+			ip = ops + ip->arg - 1;
+		NEXT;
+	CASE(BF_CLEAR)
+		p[ip->off] = 0;
+		NEXT;
+	CASE(BF_MUL)
+		p[ip->off] += *p * ip->arg;
+		NEXT;
+	CASE(BF_SCAN)
+		p = tape + scan(tape, p - tape, ip->arg);
+		NEXT;
+	CASE(BF_END)
+		return ;
+#ifndef __GNUC__
+	}
+#endif
+}
+
+int	bf_run(const t_bf_prog *prog, int fd)
+{
+	unsigned char	*tape;
+	t_out			*out;
+	int				i;
+
+	tape = malloc(BF_TAPE_SIZE);
+	out = malloc(sizeof(t_out));
+	if (!tape || !out)
+	{
+		free(tape);
+		free(out);
+		return (-1);
+	}
+	i = -1;
+	while (++i < BF_TAPE_SIZE)
+		tape[i] = 0;
+	out->fd = fd;
+	out->len = 0;
+	out->failed = 0;
+	execute(prog->ops, tape, out);
+	flush(out);
+	i = out->failed;
+	free(tape);
+	free(out);
+	return (-i);
+}
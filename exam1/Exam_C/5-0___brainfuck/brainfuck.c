@@ -0,0 +1,21 @@
+#include <unistd.h>
+#include "bf.h"
+
+int	main(int argc, char **argv)
+{
+	t_bf_prog	*prog;
+
+	if (argc < 2)
+	{
+		write(1, "\n", 1);
+		return (0);
+	}
+	prog = bf_compile(argv[1]);
+	if (!prog || bf_run(prog, 1) < 0)
+	{
+		bf_free(prog);
+		return (1);
+	}
+	bf_free(prog);
+	return (0);
+}
@@ -0,0 +1,77 @@
+#ifndef RPN_H
+# define RPN_H
+
+/*
+** A read position in a buffer that is not copied: tokens are parsed in
+** place. An expression ends at the end of the buffer or at ';', so one
+** buffer (one line of input) can hold several expressions.
+*/
+typedef struct	s_cursor
+{
+	const char	*p;
+	const char	*end;
+}				t_cursor;
+
+typedef enum	e_rpn_kind
+{
+	RPN_NUM,
+	RPN_ARG,
+	RPN_ADD,
+	RPN_SUB,
+	RPN_MUL,
+	RPN_DIV,
+	RPN_MOD,
+	RPN_END,
+	RPN_BAD
+}				t_rpn_kind;
+
+/*
+** A token or an instruction of a compiled expression: value is the number
+** for RPN_NUM and the column (from 0) for RPN_ARG, written $1, $2, ...
+*/
+typedef struct	s_rpn_op
+{
+	int			kind;
+	int			value;
+}				t_rpn_op;
+
+/*
+** An expression compiled once and run over many rows of arguments. depth
+** is the largest stack it needs and args the number of columns it reads.
+*/
+typedef struct	s_rpn_prog
+{
+	t_rpn_op	*ops;
+	int			len;
+	int			depth;
+	int			args;
+}				t_rpn_prog;
+
+/*
+** Tokens (and so stack slots) an expression of len chars can hold at most:
+** every token takes at least one char and one space.
+*/
+# define RPN_STACK_SIZE(len) ((len) / 2 + 1)
+
+t_rpn_op		rpn_next(t_cursor *c);
+void			rpn_skip(t_cursor *c);
+int				rpn_apply(int kind, int a, int b, int *result);
+
+/*
+** Evaluates the expression at c with stack, which must hold
+** RPN_STACK_SIZE(c->end - c->p) ints. Returns 1 and the result, or 0 if
+** the expression is invalid; c is then past the expression either way.
+*/
+int				rpn_eval(t_cursor *c, int *stack, int *result);
+
+/*
+** rpn_compile returns 0 if the expression is invalid or memory runs out.
+** rpn_run needs a stack of prog->depth ints and prog->args arguments; it
+** fails only on division by zero.
+*/
+int				rpn_compile(t_cursor *c, t_rpn_prog *prog);
+int				rpn_run(const t_rpn_prog *prog, const int *args, int *stack,
+					int *result);
+void			rpn_free(t_rpn_prog *prog);
+
+#endif
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rpn.h"
+
+/*
+** Benchmark of the engine against the usual exam solution: atoi on every
+** operand and a fresh stack per expression. Generates n expressions of
+** up to 16 operands (with a few invalid ones), checks that both agree on
+** every result, and times:
+**   - naive:    atoi + malloc'd stack, one expression at a time
+**   - eval:     rpn_eval over the whole buffer with one stack
+**   - compiled: one expression with $1..$8 compiled once, run over rows
+**   rpn_bench [n]
+*/
+
+static int	naive(const char *s, int *result)
+{
+	int	*stack;
+	int	sp;
+	int	ok;
+
+	stack = malloc(sizeof(int) * (strlen(s) + 1));
+	sp = 0;
+	ok = 1;
+	while (ok && *s)
+	{
+		while (*s == ' ')
+			s++;
+		if (!*s)
+			break ;
+		if (strchr("+-*/%", *s) && (s[1] == ' ' || !s[1]))
+		{
+			ok = sp >= 2 && rpn_apply(RPN_ADD + (strchr("+-*/%", *s) - "+-*/%"),
+					stack[sp - 2], stack[sp - 1], &stack[sp - 2]);
+			sp--;
+			s++;
+			continue ;
+		}
+		stack[sp++] = atoi(s);
+		s += (*s == '-' || *s == '+');
+		ok = *s >= '0' && *s <= '9';
+		while (*s >= '0' && *s <= '9')
+			s++;
+		ok = ok && (*s == ' ' || !*s);
+	}
+	*result = stack[0];
+	free(stack);
+	return (ok && sp == 1);
+}
+
+static unsigned	g_seed = 42;
+
+static int	rnd(int n)
+{
+	g_seed = g_seed * 1103515245u + 12345u;
+	return ((g_seed >> 8) % n);
+}
+
+static int	generate(char *p, int valid)
+{
+	int	len;
+	int	sp;
+	int	operands;
+
+	len = 0;
+	sp = 0;
+	operands = 2 + rnd(15);
+	while (operands > 0 || sp > 1)
+	{
+		if (operands > 0 && (sp < 2 || rnd(2)))
+		{
+			len += sprintf(p + len, "%d ", rnd(2000) - 1000);
+			operands--;
+			sp++;
+		}
+		else
+		{
+			len += sprintf(p + len, "%c ", "+-*/%"[rnd(valid ? 5 : 3)]);
+			sp--;
+		}
+	}
+	if (!valid)
+		len += sprintf(p + len, "%d", rnd(10));
+	len -= p[len - 1] == ' ';
+	p[len] = '\0';
+	return (len);
+}
+
+static double	now(void)
+{
+	struct timespec	t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (t.tv_sec + t.tv_nsec * 1e-9);
+}
+
+int	main(int argc, char **argv)
+{
+	long		n;
+	char		*buf;
+	long		len;
+	long		sum[3];
+	double		t[4];
+	int			*stack;
+	t_cursor	c;
+	t_rpn_prog	prog;
+	int			v;
+
+	n = argc > 1 ? atol(argv[1]) : 1000000;
+	buf = malloc(n * 160 + 1);
+	stack = malloc(sizeof(int) * 64);
+	len = 0;
+	for (long i = 0; i < n; i++)
+	{
+		len += generate(buf + len, rnd(20) != 0);
+		buf[len++] = '\n';
+	}
+	buf[len] = '\0';
+	sum[0] = 0;
+	sum[1] = 0;
+	t[0] = now();
+	for (char *s = buf; s < buf + len; s = strchr(s, '\n') + 1)
+	{
+		*strchr(s, '\n') = '\0';
+		sum[0] += naive(s, &v) ? v : 7;
+		s[strlen(s)] = '\n';
+	}
+	t[1] = now();
+	c.p = buf;
+	for (char *nl = memchr(buf, '\n', len); nl; nl = memchr(c.p, '\n', buf + len - c.p))
+	{
+		c.end = nl;
+		sum[1] += rpn_eval(&c, stack, &v) ? v : 7;
+		c.p = nl + 1;
+	}
+	t[2] = now();
+	c.p = "$1 $2 * $3 + $4 $5 - / $6 % $7 $8 * -";
+	c.end = c.p + strlen(c.p);
+	rpn_compile(&c, &prog);
+	sum[2] = 0;
+	for (long i = 0; i < n; i++)
+	{
+		int	args[8] = {i, 3, 5, 7, 9 + (int)(i & 1), 11, 13, 17};
+
+		sum[2] += rpn_run(&prog, args, stack, &v) ? v : 7;
+	}
+	t[3] = now();
+	printf("%ld expressions, %.1f MB: naive %.3f s, eval %.3f s (x%.1f), "
+		"compiled %.3f s%s\n", n, len / 1e6, t[1] - t[0], t[2] - t[1],
+		(t[1] - t[0]) / (t[2] - t[1]), t[3] - t[2],
+		sum[0] == sum[1] ? "" : " MISMATCH");
+	rpn_free(&prog);
+	free(stack);
+	free(buf);
+	return (sum[0] != sum[1]);
+}
@@ -0,0 +1,65 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include "rpn.h"
+
+static void	put_result(int ok, int v)
+{
+	char		digits[12];
+	unsigned	u;
+	int			i;
+
+	if (!ok)
+	{
+		write(1, "Error\n", 6);
+		return ;
+	}
+	u = v < 0 ? 0u - (unsigned)v : (unsigned)v;
+	i = 11;
+	digits[11] = '\n';
+	while (i == 11 || u > 0)
+	{
+		digits[--i] = '0' + u % 10;
+		u /= 10;
+	}
+	if (v < 0)
+		digits[--i] = '-';
+	write(1, digits + i, 12 - i);
+}
+
+/*
+** Only write, malloc and free are used here: strlen and strchr are not in
+** the subject's list. Returns 0 if the expression holds a ';', which
+** separates expressions only in rpn_stream.
+*/
+static int	find_end(const char *s, const char **end)
+{
+	while (*s && *s != ';')
+		s++;
+	*end = s;
+	return (*s == '\0');
+}
+
+/*
+** The subject's program: one expression in argv[1]. The stdin modes built
+** on the same engine are in rpn_stream.c.
+*/
+int	main(int argc, char **argv)
+{
+	t_cursor	c;
+	int			*stack;
+	int			v;
+	int			ok;
+
+	v = 0;
+	if (argc != 2 || !find_end(argv[1], &c.end))
+	{
+		put_result(0, 0);
+		return (0);
+	}
+	c.p = argv[1];
+	stack = malloc(sizeof(int) * RPN_STACK_SIZE(c.end - c.p));
+	ok = stack && rpn_eval(&c, stack, &v);
+	put_result(ok, v);
+	free(stack);
+	return (0);
+}
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include "rpn.h"
+
+int	rpn_eval(t_cursor *c, int *stack, int *result)
+{
+	t_rpn_op	t;
+	int			sp;
+
+	sp = 0;
+	t = rpn_next(c);
+	while (t.kind != RPN_END)
+	{
+		if (t.kind == RPN_NUM)
+			stack[sp++] = t.value;
+		else if (t.kind == RPN_ARG || t.kind == RPN_BAD || sp < 2
+			|| !rpn_apply(t.kind, stack[sp - 2], stack[sp - 1], &stack[sp - 2]))
+			break ;
+		else
+			sp--;
+		t = rpn_next(c);
+	}
+	rpn_skip(c);
+	if (t.kind != RPN_END || sp != 1)
+		return (0);
+	*result = stack[0];
+	return (1);
+}
+
+/*
+** The stack depth is tracked while compiling, so running cannot under- or
+** overflow and needs no checks besides division by zero.
+*/
+int	rpn_compile(t_cursor *c, t_rpn_prog *prog)
+{
+	t_rpn_op	t;
+	int			sp;
+
+	prog->ops = malloc(sizeof(t_rpn_op) * RPN_STACK_SIZE(c->end - c->p));
+	prog->len = 0;
+	prog->depth = 0;
+	prog->args = 0;
+	sp = 0;
+	t = rpn_next(c);
+	while (prog->ops && t.kind != RPN_END && t.kind != RPN_BAD
+		&& (sp >= 2 || t.kind <= RPN_ARG))
+	{
+		sp += t.kind <= RPN_ARG ? 1 : -1;
+		if (sp > prog->depth)
+			prog->depth = sp;
+		if (t.kind == RPN_ARG && t.value >= prog->args)
+			prog->args = t.value + 1;
+		prog->ops[prog->len++] = t;
+		t = rpn_next(c);
+	}
+	rpn_skip(c);
+	if (prog->ops && t.kind == RPN_END && sp == 1)
+		return (1);
+	rpn_free(prog);
+	return (0);
+}
+
+int	rpn_run(const t_rpn_prog *prog, const int *args, int *stack, int *result)
+{
+	const t_rpn_op	*op;
+	const t_rpn_op	*end;
+	int				sp;
+
+	sp = 0;
+	op = prog->ops;
+	end = op + prog->len;
+	while (op < end)
+	{
+		if (op->kind == RPN_NUM)
+			stack[sp++] = op->value;
+		else if (op->kind == RPN_ARG)
+			stack[sp++] = args[op->value];
+		else if (!rpn_apply(op->kind, stack[sp - 2], stack[sp - 1],
+				&stack[sp - 2]))
+			return (0);
+		else
+			sp--;
+		op++;
+	}
+	*result = stack[0];
+	return (1);
+}
+
+void	rpn_free(t_rpn_prog *prog)
+{
+	free(prog->ops);
+	prog->ops = NULL;
+}
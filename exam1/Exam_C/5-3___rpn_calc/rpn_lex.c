@@ -0,0 +1,93 @@
+#include <limits.h>
+#include "rpn.h"
+
+static int	is_space(char c)
+{
+	return (c == ' ' || c == '\t' || c == '\r');
+}
+
+static int	token_ends(const t_cursor *c, const char *p)
+{
+	return (p == c->end || is_space(*p) || *p == ';');
+}
+
+/*
+** Reads an int with an optional sign in place of atoi: no copy of the
+** token and no re-scan, and an operand that does not fit is an error.
+*/
+static t_rpn_op	number(t_cursor *c, int kind)
+{
+	const char	*digits;
+	const char	*p;
+	long long	v;
+	int			neg;
+
+	digits = c->p + (kind == RPN_ARG || *c->p == '-' || *c->p == '+');
+	neg = kind == RPN_NUM && *c->p == '-';
+	v = 0;
+	p = digits;
+	while (p < c->end && *p >= '0' && *p <= '9' && v <= (long long)INT_MAX + 1)
+		v = v * 10 + (*p++ - '0');
+	if (p == digits || !token_ends(c, p) || v > (long long)INT_MAX + neg
+		|| (kind == RPN_ARG && (v == 0 || v > INT_MAX)))
+		return ((t_rpn_op){RPN_BAD, 0});
+	c->p = p;
+	if (kind == RPN_ARG)
+		return ((t_rpn_op){RPN_ARG, (int)(v - 1)});
+	return ((t_rpn_op){RPN_NUM, (int)(neg ? -v : v)});
+}
+
+t_rpn_op	rpn_next(t_cursor *c)
+{
+	const char	*ops;
+	int			i;
+
+	while (c->p < c->end && is_space(*c->p))
+		c->p++;
+	if (c->p == c->end || *c->p == ';')
+		return ((t_rpn_op){RPN_END, 0});
+	ops = "+-*/%";
+	i = 0;
+	while (ops[i] && ops[i] != *c->p)
+		i++;
+	if (ops[i] && token_ends(c, c->p + 1))
+	{
+		c->p++;
+		return ((t_rpn_op){RPN_ADD + i, 0});
+	}
+	if (*c->p == '$')
+		return (number(c, RPN_ARG));
+	return (number(c, RPN_NUM));
+}
+
+/*
+** Moves past the end of the current expression (its ';', if any).
+*/
+void	rpn_skip(t_cursor *c)
+{
+	while (c->p < c->end && *c->p != ';')
+		c->p++;
+	if (c->p < c->end)
+		c->p++;
+}
+
+/*
+** Wraps around on overflow instead of being undefined; INT_MIN / -1 is the
+** one division that overflows.
+*/
+int	rpn_apply(int kind, int a, int b, int *result)
+{
+	if ((kind == RPN_DIV || kind == RPN_MOD) && b == 0)
+		return (0);
+	if (kind == RPN_ADD)
+		*result = (int)((unsigned)a + (unsigned)b);
+	else if (kind == RPN_SUB)
+		*result = (int)((unsigned)a - (unsigned)b);
+	else if (kind == RPN_MUL)
+		*result = (int)((unsigned)a * (unsigned)b);
+	else if (b == -1)
+		*result = kind == RPN_DIV ? (int)(0u - (unsigned)a) : 0;
+	else
+		*result = kind == RPN_DIV ? a / b : a % b;
+	return (1);
+}
@@ -0,0 +1,199 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "rpn.h"
+
+#define IN_SIZE 1048576
+#define OUT_SIZE 65536
+
+/*
+** stdin is read in large blocks and split into lines in place; a line that
+** does not fit grows the buffer. stack is sized for the longest possible
+** line once, so evaluating allocates nothing.
+*/
+typedef struct	s_input
+{
+	char		*buf;
+	int			*stack;
+	int			cap;
+	int			len;
+	int			start;
+	int			eof;
+}				t_input;
+
+typedef struct	s_out
+{
+	char		buf[OUT_SIZE];
+	int			len;
+}				t_out;
+
+static void	put(t_out *out, const char *s, int n)
+{
+	if (out->len + n > OUT_SIZE)
+	{
+		write(1, out->buf, out->len);
+		out->len = 0;
+	}
+	while (n-- > 0)
+		out->buf[out->len++] = *s++;
+}
+
+static void	put_result(t_out *out, int ok, int v, char sep)
+{
+	char		digits[12];
+	unsigned	u;
+	int			i;
+
+	if (!ok)
+		put(out, "Error", 5);
+	else
+	{
+		u = v < 0 ? 0u - (unsigned)v : (unsigned)v;
+		i = 12;
+		while (i == 12 || u > 0)
+		{
+			digits[--i] = '0' + u % 10;
+			u /= 10;
+		}
+		if (v < 0)
+			digits[--i] = '-';
+		put(out, digits + i, 12 - i);
+	}
+	put(out, &sep, 1);
+}
+
+static int	grow(t_input *in)
+{
+	char	*buf;
+	int		*stack;
+
+	in->cap *= 2;
+	buf = malloc(in->cap);
+	stack = malloc(sizeof(int) * RPN_STACK_SIZE(in->cap));
+	if (buf)
+		memcpy(buf, in->buf, in->len);
+	free(in->buf);
+	free(in->stack);
+	in->buf = buf;
+	in->stack = stack;
+	return (buf && stack);
+}
+
+static int	next_line(t_input *in, t_cursor *line)
+{
+	char	*nl;
+	int		got;
+
+	while (1)
+	{
+		nl = memchr(in->buf + in->start, '\n', in->len - in->start);
+		if (nl || (in->eof && in->start < in->len))
+		{
+			line->p = in->buf + in->start;
+			line->end = nl ? nl : in->buf + in->len;
+			in->start = line->end - in->buf + (nl != NULL);
+			return (1);
+		}
+		if (in->eof)
+			return (0);
+		memmove(in->buf, in->buf + in->start, in->len - in->start);
+		in->len -= in->start;
+		in->start = 0;
+		if (in->len == in->cap && !grow(in))
+			return (0);
+		got = read(0, in->buf + in->len, in->cap - in->len);
+		in->eof = got <= 0;
+		if (got > 0)
+			in->len += got;
+	}
+}
+
+/*
+** No argument: every line holds one or more expressions separated by ';', their
+** results go on one line separated by spaces.
+*/
+static void	eval_lines(t_input *in, t_out *out)
+{
+	t_cursor	line;
+	int			v;
+	int			ok;
+
+	while (next_line(in, &line))
+	{
+		ok = rpn_eval(&line, in->stack, &v);
+		while (line.p < line.end)
+		{
+			put_result(out, ok, v, ' ');
+			ok = rpn_eval(&line, in->stack, &v);
+		}
+		put_result(out, ok, v, '\n');
+	}
+}
+
+/*
+** One argument: expr is compiled once, $1, $2, ... are the columns of each
+** line of input.
+*/
+static void	run_columns(t_input *in, t_out *out, const t_rpn_prog *prog)
+{
+	t_cursor	line;
+	t_rpn_op	t;
+	int			i;
+	int			v;
+	int			ok;
+
+	while (next_line(in, &line))
+	{
+		ok = 1;
+		i = -1;
+		while (ok && ++i < prog->args)
+		{
+			t = rpn_next(&line);
+			in->stack[i] = t.value;
+			ok = t.kind == RPN_NUM;
+		}
+		ok = ok && rpn_run(prog, in->stack, in->stack + prog->args, &v);
+		put_result(out, ok, v, '\n');
+	}
+}
+
+static int	stream(const char *expr, t_out *out)
+{
+	t_input		in;
+	t_rpn_prog	prog;
+	t_cursor	c;
+	int			ok;
+
+	prog.ops = NULL;
+	c.p = expr;
+	c.end = expr ? expr + strlen(expr) : NULL;
+	if (expr && !rpn_compile(&c, &prog))
+		return (0);
+	in.cap = IN_SIZE;
+	while (expr && in.cap / 2 < prog.args + prog.depth)
+		in.cap *= 2;
+	in.buf = malloc(in.cap);
+	in.stack = malloc(sizeof(int) * RPN_STACK_SIZE(in.cap));
+	in.len = 0;
+	in.start = 0;
+	in.eof = 0;
+	ok = in.buf && in.stack;
+	if (ok && expr)
+		run_columns(&in, out, &prog);
+	else if (ok)
+		eval_lines(&in, out);
+	free(in.buf);
+	free(in.stack);
+	rpn_free(&prog);
+	return (ok);
+}
+
+int	main(int argc, char **argv)
+{
+	static t_out	out;
+
+	if (argc > 2 || !stream(argc == 2 ? argv[1] : NULL, &out))
+		put_result(&out, 0, 0, '\n');
+	write(1, out.buf, out.len);
+	return (0);
+}
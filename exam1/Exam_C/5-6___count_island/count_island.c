@@ -0,0 +1,123 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "../4-2___flood_fill/grid.h"
+
+#define LINE_MAX_LEN 1024
+#define MAX_ISLANDS 10
+
+typedef struct	s_buf
+{
+	char		*data;
+	int			len;
+	int			cap;
+}				t_buf;
+
+static int	read_all(int fd, t_buf *b)
+{
+	char	*grown;
+	int		got;
+	int		i;
+
+	b->len = 0;
+	b->cap = 4096;
+	b->data = malloc(b->cap);
+	while (b->data)
+	{
+		if (b->len == b->cap)
+		{
+			grown = malloc((size_t)b->cap * 2);
+			i = -1;
+			while (grown && ++i < b->len)
+				grown[i] = b->data[i];
+			free(b->data);
+			b->data = grown;
+			b->cap *= 2;
+			continue ;
+		}
+		got = read(fd, b->data + b->len, b->cap - b->len);
+		if (got <= 0)
+			return (got == 0);
+		b->len += got;
+	}
+	return (0);
+}
+
+/*
+** Lines of equal length made of '.' and 'X', each ending with '\n'.
+** Returns the grid or NULL if the input is empty or incoherent.
+*/
+static t_grid	*parse(const t_buf *b)
+{
+	t_grid	*g;
+	int		w;
+	int		i;
+
+	w = 0;
+	while (w < b->len && b->data[w] != '\n')
+		w++;
+	if (w == 0 || w >= LINE_MAX_LEN || b->len % (w + 1) != 0)
+		return (NULL);
+	g = grid_new(w, b->len / (w + 1));
+	i = -1;
+	while (g && ++i < b->len)
+	{
+		if ((i % (w + 1) == w) != (b->data[i] == '\n')
+			|| (b->data[i] != '\n' && b->data[i] != '.' && b->data[i] != 'X'))
+		{
+			grid_free(g);
+			return (NULL);
+		}
+		if (i % (w + 1) != w)
+			g->cells[i / (w + 1) * w + i % (w + 1)] = b->data[i];
+	}
+	return (g);
+}
+
+/*
+** Islands are numbered by their first cell in the file, which is exactly
+** the order grid_label gives them. The output reuses the input buffer.
+*/
+static int	count_island(t_buf *b)
+{
+	t_grid	*g;
+	int		*labels;
+	int		n;
+	int		i;
+
+	g = parse(b);
+	if (!g)
+		return (0);
+	labels = malloc(sizeof(int) * (size_t)g->w * g->h);
+	n = labels ? grid_label(g, 'X', labels) : MAX_ISLANDS + 1;
+	i = -1;
+	while (n <= MAX_ISLANDS && ++i < b->len)
+		if (b->data[i] == 'X')
+			b->data[i] = '0' + labels[i / (g->w + 1) * g->w + i % (g->w + 1)]
+				- 1;
+	free(labels);
+	grid_free(g);
+	return (n <= MAX_ISLANDS);
+}
+
+int	main(int argc, char **argv)
+{
+	t_buf	b;
+	int		fd;
+	int		ok;
+
+	ok = 0;
+	b.data = NULL;
+	fd = argc == 2 ? open(argv[1], O_RDONLY) : -1;
+	if (fd >= 0)
+	{
+		ok = read_all(fd, &b) && count_island(&b);
+		close(fd);
+	}
+	if (ok)
+		write(1, b.data, b.len);
+	else
+		write(1, "\n", 1);
+	free(b.data);
+	return (0);
+}
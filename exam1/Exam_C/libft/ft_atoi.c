@@ -0,0 +1,33 @@
+#include "libft.h"
+
+/*
+** atoi with two digits per step, as ft_atoi_base. Overflow wraps around
+** instead of being undefined.
+*/
+int	ft_atoi(const char *str)
+{
+	const unsigned char	*s;
+	unsigned			n;
+	unsigned			d0;
+	unsigned			d1;
+	int					neg;
+
+	s = (const unsigned char *)str;
+	while (*s == ' ' || (*s >= '\t' && *s <= '\r'))
+		s++;
+	neg = (*s == '-');
+	s += (*s == '-' || *s == '+');
+	n = 0;
+	while ((d0 = s[0] - '0') < 10)
+	{
+		d1 = s[1] - '0';
+		if (d1 >= 10)
+		{
+			n = n * 10 + d0;
+			break ;
+		}
+		n = n * 100 + (d0 * 10 + d1);
+		s += 2;
+	}
+	return ((int)(neg ? 0u - n : n));
+}
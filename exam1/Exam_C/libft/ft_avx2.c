@@ -0,0 +1,228 @@
+#include "ft_kernels.h"
+
+#ifdef FT_HAVE_AVX2
+# include <stdint.h>
+# include <immintrin.h>
+
+/*
+** The SSE2 kernels with 32-byte vectors; see ft_sse2.c.
+*/
+# define VEC 32
+# define PAGE 4096
+# define KERNEL FT_OVERREAD FT_AVX2_TARGET
+
+KERNEL static size_t	avx2_strlen(const char *s)
+{
+	const __m256i	zero = _mm256_setzero_si256();
+	const char		*p;
+	unsigned		mask;
+
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)(VEC - 1));
+	mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)p), zero)) >> (s - p);
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (1)
+	{
+		p += VEC;
+		mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_load_si256((const __m256i *)p), zero));
+		if (mask)
+			return (p - s + __builtin_ctz(mask));
+	}
+}
+
+KERNEL static int	avx2_strcmp(const char *s1, const char *s2)
+{
+	const __m256i	zero = _mm256_setzero_si256();
+	__m256i			a;
+	unsigned		mask;
+	int				i;
+
+	while (1)
+	{
+		if ((uintptr_t)s1 % VEC == 0 && (uintptr_t)s2 % PAGE <= PAGE - VEC)
+		{
+			a = _mm256_load_si256((const __m256i *)s1);
+			mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a,
+						_mm256_loadu_si256((const __m256i *)s2)))
+				& ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero));
+			if (mask != 0xFFFFFFFFu)
+			{
+				i = __builtin_ctz(~mask);
+				return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+			}
+			s1 += VEC;
+			s2 += VEC;
+			continue ;
+		}
+		if (!*s1 || *s1 != *s2)
+			return ((unsigned char)*s1 - (unsigned char)*s2);
+		s1++;
+		s2++;
+	}
+}
+
+KERNEL static unsigned	stops(__m256i v, const __m256i *set, size_t n,
+		int accept)
+{
+	__m256i	in;
+
+	in = _mm256_cmpeq_epi8(v, set[0]);
+	while (--n > 0)
+		in = _mm256_or_si256(in, _mm256_cmpeq_epi8(v, set[n]));
+	if (accept)
+		return (~(unsigned)_mm256_movemask_epi8(in));
+	return (_mm256_movemask_epi8(_mm256_or_si256(in,
+				_mm256_cmpeq_epi8(v, _mm256_setzero_si256()))));
+}
+
+/*
+** Big sets: the 256-bit bitmap as two 16-byte tables, one for the bytes
+** below 0x80 and one for the others. Entry lo of a table has bit h set
+** when the byte h * 16 + lo stops the span (h taken modulo 8), so a byte
+** is tested with two pshufb: its row by the low nibble, its bit by the
+** high one.
+*/
+typedef struct	s_nibbles
+{
+	__m256i		low;
+	__m256i		high;
+}				t_nibbles;
+
+FT_AVX2_TARGET static void	nibbles(t_nibbles *t, const t_ft_bitmap *map)
+{
+	unsigned char	low[16];
+	unsigned char	high[16];
+	int				c;
+
+	c = 0;
+	while (c < 16)
+	{
+		low[c] = 0;
+		high[c++] = 0;
+	}
+	c = 0;
+	while (c < 256)
+	{
+		if (map->bits[c >> 6] >> (c & 63) & 1)
+		{
+			if (c < 128)
+				low[c & 15] |= 1 << (c >> 4);
+			else
+				high[c & 15] |= 1 << ((c >> 4) - 8);
+		}
+		c++;
+	}
+	t->low = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)low));
+	t->high = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)high));
+}
+
+FT_AVX2_TARGET static unsigned	lookup(__m256i v, const t_nibbles *t)
+{
+	const __m256i	bits = _mm256_setr_epi8(
+			1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+			1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+	const __m256i	nibble = _mm256_set1_epi8(0x0F);
+	__m256i			row;
+	__m256i			bit;
+
+	row = _mm256_blendv_epi8(
+			_mm256_shuffle_epi8(t->low, _mm256_and_si256(v, nibble)),
+			_mm256_shuffle_epi8(t->high, _mm256_and_si256(v, nibble)), v);
+	bit = _mm256_shuffle_epi8(bits,
+			_mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+	return (_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit)));
+}
+
+KERNEL static size_t	big_span(const char *s, const char *set, size_t n,
+		int accept)
+{
+	t_ft_bitmap	map;
+	t_nibbles	t;
+	const char	*p;
+	unsigned	mask;
+
+	ft_bitmap(&map, set, n, accept);
+	nibbles(&t, &map);
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)(VEC - 1));
+	mask = lookup(_mm256_load_si256((const __m256i *)p), &t) >> (s - p);
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (1)
+	{
+		p += VEC;
+		mask = lookup(_mm256_load_si256((const __m256i *)p), &t);
+		if (mask)
+			return (p - s + __builtin_ctz(mask));
+	}
+}
+
+KERNEL static size_t	avx2_span(const char *s, const char *set, size_t n,
+		int accept)
+{
+	__m256i		vset[FT_SMALL_SET];
+	const char	*p;
+	unsigned	mask;
+	size_t		k;
+
+	if (n == 0 || n > FT_SMALL_SET)
+		return (big_span(s, set, n, accept));
+	k = 0;
+	while (k < n)
+	{
+		vset[k] = _mm256_set1_epi8(set[k]);
+		k++;
+	}
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)(VEC - 1));
+	mask = stops(_mm256_load_si256((const __m256i *)p), vset, n, accept)
+		>> (s - p);
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (1)
+	{
+		p += VEC;
+		mask = stops(_mm256_load_si256((const __m256i *)p), vset, n, accept);
+		if (mask)
+			return (p - s + __builtin_ctz(mask));
+	}
+}
+
+/*
+** pshufb reverses the bytes of each 128-bit half, then the halves swap.
+*/
+FT_AVX2_TARGET static __m256i	reverse(__m256i v)
+{
+	const __m256i	order = _mm256_setr_epi8(
+			15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	return (_mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, order),
+			_MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+FT_AVX2_TARGET static void	avx2_rev(char *s, size_t n)
+{
+	__m256i	a;
+	__m256i	b;
+	char	*end;
+
+	end = s + n;
+	while (end - s >= 2 * VEC)
+	{
+		a = _mm256_loadu_si256((const __m256i *)s);
+		b = _mm256_loadu_si256((const __m256i *)(end - VEC));
+		_mm256_storeu_si256((__m256i *)s, reverse(b));
+		_mm256_storeu_si256((__m256i *)(end - VEC), reverse(a));
+		s += VEC;
+		end -= VEC;
+	}
+	g_ft_swar.rev(s, end - s);
+}
+
+const t_ft_kernels	g_ft_avx2 = {
+	"avx2", avx2_strlen, avx2_strcmp, avx2_span, avx2_rev
+};
+
+#endif
@@ -0,0 +1,317 @@
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "libft.h"
+
+/*
+** Checks every kernel level against glibc (or a plain reference where
+** glibc has no such function), then times them.
+**   ft_bench [rounds] [MB]
+** The checks put strings at every alignment and right before a page that
+** cannot be read, so a kernel reading past the '\0' across a page faults.
+*/
+
+static unsigned	g_seed = 1;
+
+static int	rnd(int n)
+{
+	g_seed = g_seed * 1103515245u + 12345u;
+	return ((g_seed >> 8) % n);
+}
+
+/*
+** Random text over a small alphabet, so sets and prefixes match often;
+** it includes bytes above 127.
+*/
+static void	fill(char *s, size_t n)
+{
+	static const char	alphabet[] = "ab, \t\nz09-\xe9\xff";
+
+	while (n-- > 0)
+		*s++ = alphabet[rnd(sizeof(alphabet) - 1)];
+}
+
+static void	fail(const char *what, int level, const char *s)
+{
+	printf("MISMATCH %s level %s on \"%.40s\"\n", what, ft_level_name(level), s);
+	exit(1);
+}
+
+static size_t	ref_rev_check(const char *orig, const char *rev, size_t n)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < n && orig[i] == rev[n - 1 - i])
+		i++;
+	return (i == n);
+}
+
+static int	ref_split_check(char *s, char **words)
+{
+	char	*copy;
+	char	*w;
+	int		i;
+	int		ok;
+
+	copy = strdup(s);
+	i = 0;
+	ok = 1;
+	w = strtok(copy, " \t\n");
+	while (w && ok)
+	{
+		ok = words[i] && strcmp(w, words[i]) == 0;
+		free(words[i++]);
+		w = strtok(NULL, " \t\n");
+	}
+	ok = ok && words[i] == NULL;
+	free(words);
+	free(copy);
+	return (ok);
+}
+
+static void	check_strings(int level, char *page_end, int rounds)
+{
+	char	a[600];
+	char	b[600];
+	char	set[16];
+	char	*s;
+	size_t	n;
+	int		r;
+
+	r = 0;
+	while (r++ < rounds)
+	{
+		n = rnd(4) ? rnd(80) : rnd(500);
+		s = page_end - n - 1;
+		fill(s, n);
+		s[n] = '\0';
+		memcpy(a + 1 + r % 64, s, n + 1);
+		set[rnd(13)] = '\0';
+		fill(set, strlen(set));
+		set[strcspn(set, "z")] = '\0';
+		if (ft_strlen(s) != n || ft_strlen(a + 1 + r % 64) != n)
+			fail("strlen", level, s);
+		if (ft_strspn(s, set) != strspn(s, set)
+			|| ft_strcspn(s, set) != strcspn(s, set)
+			|| ft_strpbrk(s, set) != strpbrk(s, set))
+			fail("strspn/strcspn/strpbrk", level, s);
+		memcpy(b + r % 40, s, n + 1);
+		if (n > 0 && rnd(2))
+			b[r % 40 + rnd(n)] ^= 1 + rnd(255);
+		if ((ft_strcmp(s, b + r % 40) > 0) != (strcmp(s, b + r % 40) > 0)
+			|| (ft_strcmp(b + r % 40, s) < 0) != (strcmp(b + r % 40, s) < 0)
+			|| (ft_strcmp(a + 1 + r % 64, b + r % 40) == 0)
+			!= (strcmp(a + 1 + r % 64, b + r % 40) == 0))
+			fail("strcmp", level, s);
+		if (strcmp(ft_strcpy(b + r % 32, s), s) != 0)
+			fail("strcpy", level, s);
+		if (!ref_rev_check(a + 1 + r % 64, ft_strrev(s), n))
+			fail("strrev", level, s);
+		if (!ref_split_check(s, ft_split(s)))
+			fail("split", level, s);
+	}
+}
+
+static int	ref_atoi_base(const char *s, int base)
+{
+	const char	*digits = "0123456789abcdef";
+	const char	*d;
+	long		n;
+	int			neg;
+
+	neg = (*s == '-');
+	s += neg;
+	n = 0;
+	while (*s && (d = strchr(digits, *s | 0x20)) && d - digits < base)
+	{
+		n = n * base + (d - digits);
+		s++;
+	}
+	return ((int)(neg ? -n : n));
+}
+
+static void	ref_itoa_base(unsigned n, int base, char *out)
+{
+	char	tmp[40];
+	int		len;
+
+	len = 0;
+	do
+		tmp[len++] = "0123456789ABCDEF"[n % base];
+	while ((n /= base) > 0);
+	while (len > 0)
+		*out++ = tmp[--len];
+	*out = '\0';
+}
+
+static void	check_numbers(int rounds)
+{
+	char	s[64];
+	char	ref[64];
+	char	*got;
+	int		v;
+	int		base;
+	int		r;
+
+	r = 0;
+	while (r++ < rounds)
+	{
+		v = rnd(4) ? rnd(2000001) - 1000000 : (int)(g_seed * 2654435761u);
+		v = r == 1 ? INT_MIN : r == 2 ? INT_MAX : v;
+		base = 2 + rnd(15);
+		sprintf(s, "%.*s%d%s", rnd(4), " \t\n\v", v, rnd(2) ? "x1" : "");
+		sprintf(ref, "%d", v);
+		got = ft_itoa(v);
+		if (ft_atoi(s) != atoi(s) || strcmp(got, ref) != 0
+			|| ft_itoa_to(v, s) != (int)strlen(ref) || strcmp(s, ref) != 0)
+			fail("atoi/itoa", FT_BYTE, ref);
+		free(got);
+		if (base != 10)
+			ref_itoa_base((unsigned)v, base, ref);
+		got = ft_itoa_base(v, base);
+		if (strcmp(got, ref) != 0)
+			fail("itoa_base", FT_BYTE, ref);
+		fill(s, 8);
+		s[rnd(8)] = '\0';
+		if (rnd(2))
+			strcpy(s, got);
+		if (ft_atoi_base(s, base) != ref_atoi_base(s, base))
+			fail("atoi_base", FT_BYTE, s);
+		free(got);
+	}
+}
+
+static double	now(void)
+{
+	struct timespec	t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (t.tv_sec + t.tv_nsec * 1e-9);
+}
+
+/*
+** GB/s of f over the text, best of three.
+*/
+#define TIME(best, mb, expr) do { int k_ = 0; best = 1e9; \
+	while (k_++ < 3) { double t_ = now(); sink += (size_t)(expr); \
+		t_ = now() - t_; best = t_ < best ? t_ : best; } \
+	best = (mb) / 1e3 / best; } while (0)
+
+static size_t	sink;
+
+static void	bench_text(const char *name, char *text, char *copy, size_t mb,
+		int glibc)
+{
+	double	t[7];
+
+	TIME(t[0], mb, glibc ? strlen(text) : ft_strlen(text));
+	TIME(t[1], mb, glibc ? strcmp(text, copy) : ft_strcmp(text, copy));
+	TIME(t[2], mb, glibc ? strcspn(text, ";") : ft_strcspn(text, ";"));
+	TIME(t[3], mb, glibc ? strcspn(text, ";|\r") : ft_strcspn(text, ";|\r"));
+	TIME(t[4], mb, glibc ? strcspn(text, ";|\r<>[]{}()!?#$%&")
+			: ft_strcspn(text, ";|\r<>[]{}()!?#$%&"));
+	TIME(t[5], mb, glibc ? strspn(text, "abcdefghijklmnopqrstuvwxyz ,.\n")
+			: ft_strspn(text, "abcdefghijklmnopqrstuvwxyz ,.\n"));
+	TIME(t[6], 2 * mb, glibc ? 0 : (size_t)ft_strrev(ft_strrev(text)));
+	printf("| %-5s | %5.1f | %5.1f | %5.1f | %5.1f | %5.1f | %5.1f |",
+		name, t[0], t[1], t[2], t[3], t[4], t[5]);
+	if (glibc)
+		printf("   -   |\n");
+	else
+		printf(" %5.1f |\n", t[6]);
+}
+
+/*
+** Numbers of every length and sign, without signed overflow.
+*/
+#define VALUE(i) ((int)((unsigned)(i) * 7919u))
+
+static void	bench_numbers(int n)
+{
+	char	*bufs;
+	double	t[5];
+	int		i;
+
+	bufs = malloc((size_t)n * 12);
+	t[0] = now();
+	i = 0;
+	while (i++ < n)
+		sink += snprintf(bufs + (size_t)(i - 1) * 12, 12, "%d", VALUE(i));
+	t[1] = now();
+	i = 0;
+	while (i++ < n)
+		sink += ft_itoa_to(VALUE(i), bufs + (size_t)(i - 1) * 12);
+	t[2] = now();
+	i = 0;
+	while (i < n)
+		sink += atoi(bufs + (size_t)i++ * 12);
+	t[3] = now();
+	i = 0;
+	while (i < n)
+		sink += ft_atoi(bufs + (size_t)i++ * 12);
+	t[4] = now();
+	printf("\nns per number, %d numbers: snprintf %.1f, ft_itoa_to %.1f, "
+		"atoi %.1f, ft_atoi %.1f\n", n, (t[1] - t[0]) * 1e9 / n,
+		(t[2] - t[1]) * 1e9 / n, (t[3] - t[2]) * 1e9 / n,
+		(t[4] - t[3]) * 1e9 / n);
+	free(bufs);
+}
+
+int	main(int argc, char **argv)
+{
+	int		rounds;
+	size_t	mb;
+	long	page;
+	char	*pages;
+	char	*text;
+	char	*copy;
+	int		level;
+
+	rounds = argc > 1 ? atoi(argv[1]) : 200000;
+	mb = argc > 2 ? atoi(argv[2]) : 64;
+	page = sysconf(_SC_PAGESIZE);
+	pages = mmap(NULL, 2 * page, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (pages == MAP_FAILED || mprotect(pages + page, page, PROT_NONE))
+		return (1);
+	level = FT_BYTE;
+	while (level <= FT_AVX2)
+	{
+		if (ft_set_level(level) == level)
+			check_strings(level, pages + page, rounds);
+		level++;
+	}
+	check_numbers(rounds);
+	printf("checked %d strings per level and %d numbers\n", rounds, rounds);
+	text = malloc(mb << 20);
+	copy = malloc((mb << 20) + 1);
+	level = 0;
+	while ((size_t)level < (mb << 20) - 1)
+	{
+		text[level] = "abcdefghijklmnopqrstuvwxyz ,.\n"[rnd(30)];
+		level++;
+	}
+	text[(mb << 20) - 1] = '\0';
+	memcpy(copy + 1, text, mb << 20);
+	printf("\nGB/s over %zu MB of text:\n\n", mb);
+	printf("| level | strlen | strcmp | strcspn 1 | strcspn 3 | strcspn 18 "
+		"| strspn 30 | strrev |\n");
+	bench_text("glibc", text, copy + 1, mb, 1);
+	level = FT_BYTE;
+	while (level <= FT_AVX2)
+	{
+		if (ft_set_level(level) == level)
+			bench_text((char *)ft_level_name(level), text, copy + 1, mb, 0);
+		level++;
+	}
+	bench_numbers(10000000);
+	munmap(pages, 2 * page);
+	free(text);
+	free(copy);
+	return (sink == 42);
+}
@@ -0,0 +1,54 @@
+#include <stdint.h>
+#include "ft_kernels.h"
+
+/*
+** A bit per byte value, set where a span stops: on the bytes not in set
+** for an accept span, on the bytes of set for a reject span, and on '\0'
+** for both.
+*/
+void	ft_bitmap(t_ft_bitmap *map, const char *set, size_t n, int accept)
+{
+	unsigned long long	bit;
+	unsigned char		c;
+	int					k;
+
+	k = 0;
+	while (k < 4)
+		map->bits[k++] = accept ? ~0ULL : 0;
+	while (n-- > 0)
+	{
+		c = (unsigned char)*set++;
+		bit = 1ULL << (c & 63);
+		if (accept)
+			map->bits[c >> 6] &= ~bit;
+		else
+			map->bits[c >> 6] |= bit;
+	}
+	map->bits[0] |= 1;
+}
+
+#define STOP(map, c) ((map)->bits[(c) >> 6] >> ((c) & 63) & 1)
+
+/*
+** Four bytes per iteration: the four tests do not depend on each other,
+** so they overlap in the pipeline. The groups are aligned, so the bytes
+** read after the '\0' are in its group and on its page.
+*/
+FT_OVERREAD size_t	ft_bitmap_span(const char *s, const t_ft_bitmap *map)
+{
+	const unsigned char	*p;
+
+	p = (const unsigned char *)s;
+	while ((uintptr_t)p % 4)
+	{
+		if (STOP(map, *p))
+			return (p - (const unsigned char *)s);
+		p++;
+	}
+	while (!(STOP(map, p[0]) | STOP(map, p[1]) | STOP(map, p[2])
+			| STOP(map, p[3])))
+		p += 4;
+	while (!STOP(map, *p))
+		p++;
+	return (p - (const unsigned char *)s);
+}
@@ -0,0 +1,62 @@
+#include "ft_kernels.h"
+
+/*
+** The exam solutions, one byte at a time: the reference the other levels
+** are checked against.
+*/
+static size_t	byte_strlen(const char *s)
+{
+	size_t	i;
+
+	i = 0;
+	while (s[i])
+		i++;
+	return (i);
+}
+
+static int		byte_strcmp(const char *s1, const char *s2)
+{
+	while (*s1 && *s1 == *s2)
+	{
+		s1++;
+		s2++;
+	}
+	return ((unsigned char)*s1 - (unsigned char)*s2);
+}
+
+static size_t	byte_span(const char *s, const char *set, size_t n, int accept)
+{
+	size_t	i;
+	size_t	k;
+
+	i = 0;
+	while (s[i])
+	{
+		k = 0;
+		while (k < n && set[k] != s[i])
+			k++;
+		if ((k < n) != accept)
+			break ;
+		i++;
+	}
+	return (i);
+}
+
+static void		byte_rev(char *s, size_t n)
+{
+	char	c;
+	size_t	i;
+
+	i = 0;
+	while (i < n / 2)
+	{
+		c = s[i];
+		s[i] = s[n - 1 - i];
+		s[n - 1 - i] = c;
+		i++;
+	}
+}
+
+const t_ft_kernels	g_ft_byte = {
+	"byte", byte_strlen, byte_strcmp, byte_span, byte_rev
+};
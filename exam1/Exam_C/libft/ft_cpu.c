@@ -0,0 +1,86 @@
+#include <stddef.h>
+#include "libft.h"
+#include "ft_kernels.h"
+
+/*
+** The kernel table in use, chosen on the first call. Several threads may
+** choose at once; they store the same pointer, and relaxed atomics make
+** that well-defined.
+*/
+static const t_ft_kernels	*g_current;
+
+#ifdef __GNUC__
+# define LOAD(p) __atomic_load_n(&(p), __ATOMIC_RELAXED)
+# define STORE(p, v) __atomic_store_n(&(p), (v), __ATOMIC_RELAXED)
+#else
+# define LOAD(p) (p)
+# define STORE(p, v) ((p) = (v))
+#endif
+
+/*
+** The best level of this CPU. __builtin_cpu_supports reads CPUID, and for
+** AVX2 also checks (XGETBV) that the OS saves the 256-bit registers.
+*/
+static int	cpu_level(void)
+{
+#ifdef FT_HAVE_AVX2
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return (FT_AVX2);
+#endif
+#ifdef __SSE2__
+	return (FT_SSE2);
+#else
+	return (FT_SWAR);
+#endif
+}
+
+static const t_ft_kernels	*table(int level)
+{
+	if (level > cpu_level())
+		level = cpu_level();
+#ifdef FT_HAVE_AVX2
+	if (level == FT_AVX2)
+		return (&g_ft_avx2);
+#endif
+#ifdef __SSE2__
+	if (level == FT_SSE2)
+		return (&g_ft_sse2);
+#endif
+	if (level >= FT_SWAR)
+		return (&g_ft_swar);
+	return (&g_ft_byte);
+}
+
+const t_ft_kernels	*ft_kernels(void)
+{
+	const t_ft_kernels	*k;
+
+	k = LOAD(g_current);
+	if (k == NULL)
+	{
+		k = table(FT_AVX2);
+		STORE(g_current, k);
+	}
+	return (k);
+}
+
+int	ft_set_level(int level)
+{
+	const t_ft_kernels	*k;
+
+	k = table(level);
+	STORE(g_current, k);
+	if (k == &g_ft_byte)
+		return (FT_BYTE);
+	if (k == &g_ft_swar)
+		return (FT_SWAR);
+	return (level > cpu_level() ? cpu_level() : level);
+}
+
+const char	*ft_level_name(int level)
+{
+	if (level < 0)
+		return (ft_kernels()->name);
+	return (table(level)->name);
+}
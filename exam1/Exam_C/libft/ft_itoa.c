@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include "libft.h"
+
+/*
+** Two digits per division: "00".."99" as 200 chars, so n % 100 is copied
+** with two loads instead of computed with two divisions.
+*/
+static const char	g_pairs[201] =
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859"
+	"6061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+static int	count_digits(unsigned n)
+{
+	int	len;
+
+	len = 1;
+	while (n >= 10000)
+	{
+		n /= 10000;
+		len += 4;
+	}
+	len += (n >= 10) + (n >= 100) + (n >= 1000);
+	return (len);
+}
+
+/*
+** Writes the decimal digits of n backwards, ending just before end.
+*/
+static void	write_digits(unsigned n, char *end)
+{
+	const char	*pair;
+
+	while (n >= 100)
+	{
+		pair = g_pairs + n % 100 * 2;
+		n /= 100;
+		*--end = pair[1];
+		*--end = pair[0];
+	}
+	if (n >= 10)
+	{
+		*--end = g_pairs[n * 2 + 1];
+		*--end = g_pairs[n * 2];
+	}
+	else
+		*--end = '0' + n;
+}
+
+int			ft_itoa_to(int nbr, char *dst)
+{
+	unsigned	n;
+	int			len;
+
+	n = nbr < 0 ? 0u - (unsigned)nbr : (unsigned)nbr;
+	len = (nbr < 0) + count_digits(n);
+	write_digits(n, dst + len);
+	if (nbr < 0)
+		*dst = '-';
+	dst[len] = '\0';
+	return (len);
+}
+
+char		*ft_itoa(int nbr)
+{
+	char	buf[12];
+	char	*str;
+	int		len;
+	int		i;
+
+	len = ft_itoa_to(nbr, buf);
+	str = malloc(len + 1);
+	if (str == NULL)
+		return (NULL);
+	i = 0;
+	while (i <= len)
+	{
+		str[i] = buf[i];
+		i++;
+	}
+	return (str);
+}
@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include "libft.h"
+
+/*
+** Base 10 is ft_itoa. Bases 2, 4, 8 and 16 take digits with shifts and
+** masks, the others with division; outside base 10 the value is unsigned,
+** as in the subject.
+*/
+char	*ft_itoa_base(int value, int base)
+{
+	const char	*digits = "0123456789ABCDEF";
+	unsigned	n;
+	int			shift;
+	int			len;
+	char		*str;
+
+	if (base == 10)
+		return (ft_itoa(value));
+	if (base < 2 || base > 16)
+		return (NULL);
+	shift = 0;
+	while ((1 << shift) < base)
+		shift++;
+	if ((1 << shift) != base)
+		shift = 0;
+	len = 1;
+	n = (unsigned)value;
+	while (n >= (unsigned)base)
+	{
+		n = shift ? n >> shift : n / base;
+		len++;
+	}
+	str = malloc(len + 1);
+	if (str == NULL)
+		return (NULL);
+	str[len] = '\0';
+	n = (unsigned)value;
+	while (len-- > 0)
+	{
+		str[len] = digits[shift ? n & (base - 1) : n % base];
+		n = shift ? n >> shift : n / base;
+	}
+	return (str);
+}
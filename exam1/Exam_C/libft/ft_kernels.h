@@ -0,0 +1,67 @@
+#ifndef FT_KERNELS_H
+# define FT_KERNELS_H
+
+# include <stddef.h>
+
+/*
+** The loops that touch every byte, one table per level:
+**   strlen  length of s
+**   strcmp  as strcmp
+**   span    length of the prefix of s whose bytes are all in set
+**           (accept) or all not in set (!accept). set has n bytes, none
+**           of them '\0'; the scan always stops at '\0'.
+**   rev     reverses the n bytes at s
+*/
+typedef struct	s_ft_kernels
+{
+	const char	*name;
+	size_t		(*strlen)(const char *s);
+	int			(*strcmp)(const char *s1, const char *s2);
+	size_t		(*span)(const char *s, const char *set, size_t n,
+					int accept);
+	void		(*rev)(char *s, size_t n);
+}				t_ft_kernels;
+
+extern const t_ft_kernels	g_ft_byte;
+extern const t_ft_kernels	g_ft_swar;
+extern const t_ft_kernels	g_ft_sse2;
+extern const t_ft_kernels	g_ft_avx2;
+
+const t_ft_kernels	*ft_kernels(void);
+
+/*
+** The faster kernels read whole aligned words or vectors, so they may
+** read past the '\0' up to the end of its word. An aligned word never
+** crosses a page, so this cannot fault, but ASan would report it.
+*/
+# ifdef __GNUC__
+#  define FT_OVERREAD __attribute__((no_sanitize_address))
+# else
+#  define FT_OVERREAD
+# endif
+
+/*
+** The AVX2 kernels are compiled for AVX2 function by function, so the
+** rest of the library runs on any x86 and needs no -mavx2.
+*/
+# if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define FT_HAVE_AVX2
+#  define FT_AVX2_TARGET __attribute__((target("avx2")))
+# endif
+
+/*
+** Sets of up to FT_SMALL_SET bytes are compared one byte of the set at a
+** time over whole vectors; bigger sets use a 256-bit bitmap.
+*/
+# define FT_SMALL_SET 8
+
+typedef struct	s_ft_bitmap
+{
+	unsigned long long	bits[4];
+}				t_ft_bitmap;
+
+void		ft_bitmap(t_ft_bitmap *map, const char *set, size_t n,
+				int accept);
+size_t		ft_bitmap_span(const char *s, const t_ft_bitmap *map);
+
+#endif
@@ -0,0 +1,159 @@
+#include "ft_kernels.h"
+
+#ifdef __SSE2__
+# include <stdint.h>
+# include <emmintrin.h>
+
+/*
+** 16 bytes per step. Loads are aligned down to 16, so the bytes read
+** before the string or after its '\0' are on the same page; the bits of
+** the bytes before the string are shifted out of the first mask.
+*/
+# define VEC 16
+# define PAGE 4096
+
+FT_OVERREAD static size_t	sse2_strlen(const char *s)
+{
+	const __m128i	zero = _mm_setzero_si128();
+	const char		*p;
+	unsigned		mask;
+
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)(VEC - 1));
+	mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_load_si128((const __m128i *)p), zero)) >> (s - p);
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (1)
+	{
+		p += VEC;
+		mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), zero));
+		if (mask)
+			return (p - s + __builtin_ctz(mask));
+	}
+}
+
+/*
+** As the SWAR strcmp: s1 aligned, s2 read whole only away from the end
+** of its page. A bit of mask is set where the bytes are equal and not
+** '\0'; the first clear bit is the answer.
+*/
+FT_OVERREAD static int	sse2_strcmp(const char *s1, const char *s2)
+{
+	const __m128i	zero = _mm_setzero_si128();
+	__m128i			a;
+	unsigned		mask;
+	int				i;
+
+	while (1)
+	{
+		if ((uintptr_t)s1 % VEC == 0 && (uintptr_t)s2 % PAGE <= PAGE - VEC)
+		{
+			a = _mm_load_si128((const __m128i *)s1);
+			mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a,
+						_mm_loadu_si128((const __m128i *)s2)))
+				& ~_mm_movemask_epi8(_mm_cmpeq_epi8(a, zero));
+			if (mask != 0xFFFF)
+			{
+				i = __builtin_ctz(~mask);
+				return ((unsigned char)s1[i] - (unsigned char)s2[i]);
+			}
+			s1 += VEC;
+			s2 += VEC;
+			continue ;
+		}
+		if (!*s1 || *s1 != *s2)
+			return ((unsigned char)*s1 - (unsigned char)*s2);
+		s1++;
+		s2++;
+	}
+}
+
+/*
+** Small sets: one compare per byte of the set over the whole vector. The
+** mask has a bit set where the span stops.
+*/
+FT_OVERREAD static unsigned	stops(__m128i v, const __m128i *set, size_t n,
+		int accept)
+{
+	__m128i	in;
+
+	in = _mm_cmpeq_epi8(v, set[0]);
+	while (--n > 0)
+		in = _mm_or_si128(in, _mm_cmpeq_epi8(v, set[n]));
+	if (accept)
+		return (~_mm_movemask_epi8(in) & 0xFFFF);
+	return (_mm_movemask_epi8(_mm_or_si128(in,
+				_mm_cmpeq_epi8(v, _mm_setzero_si128()))));
+}
+
+FT_OVERREAD static size_t	sse2_span(const char *s, const char *set,
+		size_t n, int accept)
+{
+	t_ft_bitmap	map;
+	__m128i		vset[FT_SMALL_SET];
+	const char	*p;
+	unsigned	mask;
+	size_t		k;
+
+	if (n == 0 || n > FT_SMALL_SET)
+	{
+		ft_bitmap(&map, set, n, accept);
+		return (ft_bitmap_span(s, &map));
+	}
+	k = 0;
+	while (k < n)
+	{
+		vset[k] = _mm_set1_epi8(set[k]);
+		k++;
+	}
+	p = (const char *)((uintptr_t)s & ~(uintptr_t)(VEC - 1));
+	mask = stops(_mm_load_si128((const __m128i *)p), vset, n, accept)
+		>> (s - p);
+	if (mask)
+		return (__builtin_ctz(mask));
+	while (1)
+	{
+		p += VEC;
+		mask = stops(_mm_load_si128((const __m128i *)p), vset, n, accept);
+		if (mask)
+			return (p - s + __builtin_ctz(mask));
+	}
+}
+
+/*
+** Reverses the bytes of v with SSE2 only: the 32-bit lanes, then the
+** 16-bit halves of each lane, then the bytes of each half.
+*/
+static __m128i	reverse(__m128i v)
+{
+	v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+	v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+	v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+	return (_mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+}
+
+static void	sse2_rev(char *s, size_t n)
+{
+	__m128i	a;
+	__m128i	b;
+	char	*end;
+
+	end = s + n;
+	while (end - s >= 2 * VEC)
+	{
+		a = _mm_loadu_si128((const __m128i *)s);
+		b = _mm_loadu_si128((const __m128i *)(end - VEC));
+		_mm_storeu_si128((__m128i *)s, reverse(b));
+		_mm_storeu_si128((__m128i *)(end - VEC), reverse(a));
+		s += VEC;
+		end -= VEC;
+	}
+	g_ft_swar.rev(s, end - s);
+}
+
+const t_ft_kernels	g_ft_sse2 = {
+	"sse2", sse2_strlen, sse2_strcmp, sse2_span, sse2_rev
+};
+
+#endif
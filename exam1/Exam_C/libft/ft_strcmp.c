@@ -0,0 +1,7 @@
+#include "libft.h"
+#include "ft_kernels.h"
+
+int	ft_strcmp(const char *s1, const char *s2)
+{
+	return (ft_kernels()->strcmp(s1, s2));
+}
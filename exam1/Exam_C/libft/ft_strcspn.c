@@ -0,0 +1,10 @@
+#include "libft.h"
+#include "ft_kernels.h"
+
+size_t	ft_strcspn(const char *s, const char *reject)
+{
+	const t_ft_kernels	*k;
+
+	k = ft_kernels();
+	return (k->span(s, reject, k->strlen(reject), 0));
+}
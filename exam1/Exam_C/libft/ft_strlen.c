@@ -0,0 +1,7 @@
+#include "libft.h"
+#include "ft_kernels.h"
+
+size_t	ft_strlen(const char *str)
+{
+	return (ft_kernels()->strlen(str));
+}
@@ -0,0 +1,11 @@
+#include "libft.h"
+#include "ft_kernels.h"
+
+char	*ft_strpbrk(const char *s1, const char *s2)
+{
+	const t_ft_kernels	*k;
+
+	k = ft_kernels();
+	s1 += k->span(s1, s2, k->strlen(s2), 0);
+	return (*s1 ? (char *)s1 : NULL);
+}
@@ -0,0 +1,11 @@
+#include "libft.h"
+#include "ft_kernels.h"
+
+char	*ft_strrev(char *str)
+{
+	const t_ft_kernels	*k;
+
+	k = ft_kernels();
+	k->rev(str, k->strlen(str));
+	return (str);
+}
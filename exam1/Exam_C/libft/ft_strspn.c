@@ -0,0 +1,10 @@
+#include "libft.h"
+#include "ft_kernels.h"
+
+size_t	ft_strspn(const char *s, const char *accept)
+{
+	const t_ft_kernels	*k;
+
+	k = ft_kernels();
+	return (k->span(s, accept, k->strlen(accept), 1));
+}
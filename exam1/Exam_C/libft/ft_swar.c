@@ -0,0 +1,151 @@
+#include <stdint.h>
+#include <string.h>
+#include "ft_kernels.h"
+
+/*
+** Eight bytes as one word. (w - 0x01..01) & ~w & 0x80..80 is non-zero
+** exactly when one of the bytes of w is zero; the byte itself is then
+** found one byte at a time, which does not depend on the byte order.
+*/
+#ifdef __GNUC__
+typedef unsigned long long	t_word __attribute__((may_alias));
+typedef unsigned long long	t_uword __attribute__((may_alias, aligned(1)));
+#else
+typedef unsigned long long	t_word;
+typedef unsigned long long	t_uword;
+#endif
+
+#define ONES 0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+#define HAS_ZERO(w) (((w) - ONES) & ~(w) & HIGHS)
+#define PAGE 4096
+
+FT_OVERREAD static size_t	swar_strlen(const char *s)
+{
+	const char	*p;
+	const t_word	*w;
+
+	p = s;
+	while ((uintptr_t)p % 8)
+	{
+		if (!*p)
+			return (p - s);
+		p++;
+	}
+	w = (const t_word *)p;
+	while (!HAS_ZERO(*w))
+		w++;
+	p = (const char *)w;
+	while (*p)
+		p++;
+	return (p - s);
+}
+
+/*
+** s1 is read in aligned words; s2 has its own alignment, so a word of s2
+** is read whole only when it does not cross into the next page. A word
+** with a difference or a '\0' is finished one byte at a time.
+*/
+FT_OVERREAD static int	swar_strcmp(const char *s1, const char *s2)
+{
+	unsigned long long	a;
+
+	while (1)
+	{
+		if ((uintptr_t)s1 % 8 == 0 && (uintptr_t)s2 % PAGE <= PAGE - 8)
+		{
+			a = *(const t_word *)s1;
+			if (a == *(const t_uword *)s2 && !HAS_ZERO(a))
+			{
+				s1 += 8;
+				s2 += 8;
+				continue ;
+			}
+		}
+		if (!*s1 || *s1 != *s2)
+			return ((unsigned char)*s1 - (unsigned char)*s2);
+		s1++;
+		s2++;
+	}
+}
+
+/*
+** One byte c or its absence is found like '\0': a byte of w ^ c..c is zero
+** where w has c.
+*/
+FT_OVERREAD static size_t	swar_span(const char *s, const char *set,
+		size_t n, int accept)
+{
+	t_ft_bitmap			map;
+	const char			*p;
+	unsigned long long	c;
+	unsigned long long	w;
+
+	if (n != 1 || accept)
+	{
+		ft_bitmap(&map, set, n, accept);
+		return (ft_bitmap_span(s, &map));
+	}
+	p = s;
+	while ((uintptr_t)p % 8)
+	{
+		if (!*p || *p == *set)
+			return (p - s);
+		p++;
+	}
+	c = ONES * (unsigned char)*set;
+	w = *(const t_word *)p;
+	while (!HAS_ZERO(w) && !HAS_ZERO(w ^ c))
+	{
+		p += 8;
+		w = *(const t_word *)p;
+	}
+	while (*p && *p != *set)
+		p++;
+	return (p - s);
+}
+
+static unsigned long long	bswap(unsigned long long w)
+{
+#ifdef __GNUC__
+	return (__builtin_bswap64(w));
+#else
+	w = (w & 0x00FF00FF00FF00FFULL) << 8 | (w >> 8 & 0x00FF00FF00FF00FFULL);
+	w = (w & 0x0000FFFF0000FFFFULL) << 16 | (w >> 16 & 0x0000FFFF0000FFFFULL);
+	return (w << 32 | w >> 32);
+#endif
+}
+
+/*
+** Swaps a word from each end per step, each reversed with one byte swap.
+*/
+static void	swar_rev(char *s, size_t n)
+{
+	unsigned long long	a;
+	unsigned long long	b;
+	char				*end;
+	char				c;
+
+	end = s + n;
+	while (end - s >= 16)
+	{
+		memcpy(&a, s, 8);
+		memcpy(&b, end - 8, 8);
+		a = bswap(a);
+		b = bswap(b);
+		memcpy(s, &b, 8);
+		memcpy(end - 8, &a, 8);
+		s += 8;
+		end -= 8;
+	}
+	while (end - s >= 2)
+	{
+		c = *s;
+		*s++ = *--end;
+		*end = c;
+	}
+}
+
+const t_ft_kernels	g_ft_swar = {
+	"swar", swar_strlen, swar_strcmp, swar_span, swar_rev
+};
@@ -0,0 +1,44 @@
+#ifndef LIBFT_H
+# define LIBFT_H
+
+# include <stddef.h>
+
+/*
+** The exam's libc re-implementations as one library. The scanning
+** functions (strlen, strcpy, strcmp, strspn, strcspn, strpbrk, strrev,
+** split) run on the best kernels the CPU has; see ft_kernels.h.
+*/
+size_t		ft_strlen(const char *str);
+char		*ft_strcpy(char *s1, const char *s2);
+int			ft_strcmp(const char *s1, const char *s2);
+size_t		ft_strspn(const char *s, const char *accept);
+size_t		ft_strcspn(const char *s, const char *reject);
+char		*ft_strpbrk(const char *s1, const char *s2);
+char		*ft_strrev(char *str);
+char		**ft_split(char *str);
+
+int			ft_atoi(const char *str);
+int			ft_atoi_base(const char *str, int str_base);
+char		*ft_itoa(int nbr);
+char		*ft_itoa_base(int value, int base);
+
+/*
+** ft_itoa without malloc: writes nbr and a '\0' to dst, which needs 12
+** bytes, and returns the number of digits and sign written.
+*/
+int			ft_itoa_to(int nbr, char *dst);
+
+/*
+** Kernel levels, from the exam solutions to AVX2. ft_set_level picks one
+** (for tests and benchmarks); a level the CPU does not have falls back to
+** the best one it has. ft_level_name(-1) names the current level.
+*/
+# define FT_BYTE 0
+# define FT_SWAR 1
+# define FT_SSE2 2
+# define FT_AVX2 3
+
+int			ft_set_level(int level);
+const char	*ft_level_name(int level);
+
+#endif
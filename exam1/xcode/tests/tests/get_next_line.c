@@ -0,0 +1,173 @@
+//
+//  get_next_line.c
+//  tests
+//
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "get_next_line.h"
+
+static t_reader	*g_readers[GNL_MAX_FD];
+
+int reader_init(t_reader *r, int fd) {
+	r->fd = fd;
+	r->cap = GNL_BUFFER_SIZE;
+	r->buf = malloc(r->cap);
+	r->start = 0;
+	r->scan = 0;
+	r->end = 0;
+	r->eof = 0;
+	return (r->buf != NULL);
+}
+
+void reader_free(t_reader *r) {
+	free(r->buf);
+	r->buf = NULL;
+}
+
+static t_slice cut(t_reader *r, size_t stop, size_t next) {
+	t_slice	line;
+	
+	line.data = r->buf + r->start;
+	line.len = stop - r->start;
+	line.newline = (next > stop);
+	r->buf[stop] = '\0';
+	r->start = next;
+	r->scan = next;
+	return (line);
+}
+
+// Освобождает место в конце буфера: сначала сдвигает остаток строки
+// в начало, и только если строка занимает весь буфер, удваивает его.
+// Последний байт всегда свободен под '\0'.
+static int make_room(t_reader *r) {
+	char	*new_buf;
+	
+	if (r->start == r->end)
+	{
+		r->start = 0;	// все отдано: читаем снова с начала буфера
+		r->scan = 0;
+		r->end = 0;
+	}
+	if (r->end + 1 < r->cap)
+	{
+		return (1);
+	}
+	if (r->start > 0)
+	{
+		memmove(r->buf, r->buf + r->start, r->end - r->start);
+		r->end -= r->start;
+		r->scan -= r->start;
+		r->start = 0;
+		return (1);
+	}
+	if (r->cap > (size_t)-1 / 2)
+	{
+		return (0);
+	}
+	new_buf = realloc(r->buf, r->cap * 2);
+	if (new_buf == NULL)
+	{
+		return (0);
+	}
+	r->buf = new_buf;
+	r->cap *= 2;
+	return (1);
+}
+
+int reader_next(t_reader *r, t_slice *line) {
+	char	*nl;
+	ssize_t	bytes_read;
+	
+	while (1)
+	{
+		// memchr из libc векторизован (SSE2/AVX2 или NEON) и смотрит
+		// только новые байты: уже проверенные не сканируются повторно
+		nl = memchr(r->buf + r->scan, '\n', r->end - r->scan);
+		if (nl != NULL)
+		{
+			*line = cut(r, nl - r->buf, nl - r->buf + 1);
+			return (1);
+		}
+		r->scan = r->end;
+		if (r->eof)
+		{
+			if (r->start == r->end)
+			{
+				return (0);
+			}
+			*line = cut(r, r->end, r->end);	// последняя строка без '\n'
+			return (1);
+		}
+		if (!make_room(r))
+		{
+			return (-1);
+		}
+		bytes_read = read(r->fd, r->buf + r->end, r->cap - r->end - 1);
+		if (bytes_read < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (bytes_read < 0)
+		{
+			return (-1);
+		}
+		r->eof = (bytes_read == 0);
+		r->end += bytes_read;
+	}
+}
+
+int get_next_line_slice(int fd, t_slice *line) {
+	t_reader	*r;
+	int			res;
+	
+	if (fd < 0 || fd >= GNL_MAX_FD)
+	{
+		return (-1);
+	}
+	r = g_readers[fd];
+	if (r == NULL)
+	{
+		r = malloc(sizeof(t_reader));
+		if (r == NULL || !reader_init(r, fd))
+		{
+			free(r);
+			return (-1);
+		}
+		g_readers[fd] = r;
+	}
+	res = reader_next(r, line);
+	if (res != 1)
+	{
+		get_next_line_close(fd);
+	}
+	return (res);
+}
+
+char *get_next_line(int fd) {
+	t_slice	line;
+	char	*copy;
+	
+	if (get_next_line_slice(fd, &line) != 1)
+	{
+		return (NULL);
+	}
+	copy = malloc(line.len + 1);
+	if (copy != NULL)
+	{
+		memcpy(copy, line.data, line.len + 1);
+	}
+	return (copy);
+}
+
+void get_next_line_close(int fd) {
+	if (fd < 0 || fd >= GNL_MAX_FD || g_readers[fd] == NULL)
+	{
+		return;
+	}
+	reader_free(g_readers[fd]);
+	free(g_readers[fd]);
+	g_readers[fd] = NULL;
+}
@@ -0,0 +1,46 @@
+//
+//  get_next_line.h
+//  tests
+//
+
+#ifndef GET_NEXT_LINE_H
+#define GET_NEXT_LINE_H
+
+#include <stddef.h>
+
+#define GNL_BUFFER_SIZE (1 << 16)	// начальный размер буфера одного fd
+#define GNL_MAX_FD 1024
+
+// Строка внутри буфера читателя, без копирования. Перевод строки отрезан,
+// на его месте '\0', поэтому data можно печатать как обычную строку.
+// Действительна до следующего чтения из того же читателя.
+typedef struct s_slice {
+	const char	*data;
+	size_t		len;
+	int			newline;	// 1, если строка кончалась '\n', 0 для последней без него
+}	t_slice;
+
+// Один буфер на fd: read() пишет в него большими блоками, строки отдаются
+// срезами. Если строка не помещается, буфер растет вдвое.
+typedef struct s_reader {
+	int			fd;
+	char		*buf;
+	size_t		cap;
+	size_t		start;	// начало еще не отданных данных
+	size_t		scan;	// до этого места '\n' уже искали
+	size_t		end;	// конец считанных данных
+	int			eof;
+}	t_reader;
+
+// 1 - строка в line, 0 - конец файла, -1 - ошибка read или malloc
+int		reader_init(t_reader *r, int fd);
+int		reader_next(t_reader *r, t_slice *line);
+void	reader_free(t_reader *r);
+
+// То же для нескольких fd сразу: читатель создается при первом чтении fd
+// и удаляется на конце файла, ошибке или get_next_line_close
+int		get_next_line_slice(int fd, t_slice *line);
+char	*get_next_line(int fd);	// копия строки через malloc
+void	get_next_line_close(int fd);
+
+#endif
@@ -8,8 +8,10 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
-
-#define BUFFER_SIZE 20
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include "get_next_line.h"
 
 #define FALSE 0
 #define TRUE 1
@@ -41,34 +43,6 @@ size_t my_strlen(const char *str) {
 	return (s - str);
 }
 
-bool has_eol_last_symbol(const char *str) {
-//	const char *s;
-	size_t len;
-	
-	len = my_strlen(str);
-	if (str == NULL || len == 0)
-	{
-		return (FALSE);
-	}
-//	s = str;
-//	printf("%s\n", str);
-//	printf("%d%c", len, *(str + len - 1));
-	if(*(str + len - 1) == '\n')
-	{
-		return (TRUE);
-	}
-	return (FALSE);
-//	while(*s)
-//	{
-//		++s;
-//		if(*s == "\n")
-//		{
-//			return (TRUE);
-//		}
-//	}
-//	return (FALSE);
-}
-
 bool change(char **str, char *new) {
 	size_t new_len;
 	
@@ -87,62 +61,112 @@ bool change(char **str, char *new) {
 	return (TRUE);
 }
 
+// Читает строку из stdin без перевода строки. Раньше каждый блок в 20 байт
+// делал realloc всей строки и пересчитывал ее длину (квадратично от длины);
+// теперь строка берется срезом из общего буфера get_next_line и копируется
+// один раз.
 bool read_string(char **str, int i) {
+	t_slice	line;
+	char	*new_str;
 	
-	char	buffer[BUFFER_SIZE];
-	char	*tmp;
-	char	*new_str;	// собираем здесь все что считали
-	ssize_t	bytes_read;
-	size_t	total_read;
-	
-	total_read = 0;
-	new_str = NULL;
-	while(1)
+	(void)i;
+	if (get_next_line_slice(0, &line) != 1)
 	{
-		bytes_read = read(0, buffer, BUFFER_SIZE - 1);
-//		if(i == 1)
-//		{
-//			bytes_read = 6;
-//			my_strcpy(buffer, "hello\n\0");
-//		}
-//		else
-//		{
-//			bytes_read = 16;
-//			my_strcpy(buffer, "ZZZZZZZZZZZZZZZ\n\0");
-//		}
-		tmp = realloc(new_str, (total_read + bytes_read + 1) * sizeof(char));
-		if (bytes_read == -1 || tmp == NULL) {
-			free(new_str);
-			return FALSE;
-		}
-		new_str = tmp;
-		buffer[bytes_read] = '\0';
-		my_strcpy(new_str + total_read, buffer);
-		total_read += bytes_read;
-		if(has_eol_last_symbol(new_str))
-		{
-			*(new_str + total_read - 1) = '\0'; // заменяем перевод строки
-			free(*str);
-			*str = new_str;
-//			my_strcpy(*str, new_str);
-			break;
-		}
+		return (FALSE);
 	}
+	new_str = malloc(line.len + 1);
+	if (new_str == NULL)
+	{
+		return (FALSE);
+	}
+	memcpy(new_str, line.data, line.len + 1);
+	free(*str);
+	*str = new_str;
 	
 	printf("after. %s\n", *str);
 	return (TRUE);
 }
 
+// tests FILE...: читает все файлы по очереди по строке (несколько fd сразу)
+// и печатает число строк, байт и скорость чтения.
+int read_files(int count, char **paths) {
+	t_reader		readers[GNL_MAX_FD];
+	size_t			lines[GNL_MAX_FD];
+	size_t			bytes[GNL_MAX_FD];
+	bool			done[GNL_MAX_FD];
+	t_slice			line;
+	struct timespec	start, finish;
+	int				open_count, k, res;
+	double			seconds;
+	size_t			total;
+	
+	if (count > GNL_MAX_FD)
+	{
+		count = GNL_MAX_FD;
+	}
+	for (k = 0; k < count; k++)
+	{
+		lines[k] = 0;
+		bytes[k] = 0;
+		done[k] = !reader_init(&readers[k], open(paths[k], O_RDONLY)) || readers[k].fd < 0;
+		if (done[k])
+		{
+			perror(paths[k]);
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	open_count = count;
+	while (open_count > 0)
+	{
+		open_count = 0;
+		for (k = 0; k < count; k++)
+		{
+			if (done[k])
+			{
+				continue;
+			}
+			res = reader_next(&readers[k], &line);
+			if (res != 1)
+			{
+				done[k] = TRUE;
+				continue;
+			}
+			lines[k]++;
+			bytes[k] += line.len + line.newline;
+			open_count++;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &finish);
+	seconds = (finish.tv_sec - start.tv_sec) + (finish.tv_nsec - start.tv_nsec) * 1e-9;
+	total = 0;
+	for (k = 0; k < count; k++)
+	{
+		printf("%s: %zu lines, %zu bytes\n", paths[k], lines[k], bytes[k]);
+		total += bytes[k];
+		if (readers[k].fd >= 0)
+		{
+			close(readers[k].fd);
+		}
+		reader_free(&readers[k]);
+	}
+	printf("%.3f s, %.0f MB/s\n", seconds, total / seconds / 1e6);
+	return (0);
+}
 
 void print_memory_address(char *str) {
 	printf("Адрес str: %p\n", (void*)str);
 }
 
 
-int main(void) {
+int main(int argc, char **argv) {
 	char	*str;
 	bool	res;
 	
+	if (argc > 1)
+	{
+		return (read_files(argc - 1, argv + 1));
+	}
+	
 //	printf("sizeof size_t. %lu\n", sizeof(size_t));
 //	printf("sizeof ssize_t. %lu\n", sizeof(ssize_t));
 	//	printf("sizeof bool. %lu\n", sizeof(bool));